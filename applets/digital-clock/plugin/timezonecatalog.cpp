@@ -0,0 +1,129 @@
+/*
+    SPDX-FileCopyrightText: 2014 Kai Uwe Broulik <kde@privat.broulik.de>
+    SPDX-FileCopyrightText: 2014 Martin Klapetek <mklapetek@kde.org>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "timezonecatalog.h"
+
+#include <KLocalizedString>
+
+#include <QDateTime>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+// How long to trust an offset when the backend cannot tell the next transition
+constexpr qint64 s_offsetFallbackValidity = 60 * 60 * 1000;
+}
+
+Q_GLOBAL_STATIC(TimeZoneCatalog, s_timeZoneCatalog)
+
+TimeZoneCatalog *TimeZoneCatalog::self()
+{
+    return s_timeZoneCatalog;
+}
+
+TimeZoneCatalog::TimeZoneCatalog()
+{
+    struct Zone {
+        QTimeZone zone;
+        QString city;
+        QString continent;
+        // CITY | COUNTRY | CONTINENT
+        QString sortKey;
+    };
+
+    const QList<QByteArray> systemTimeZones = QTimeZone::availableTimeZoneIds();
+
+    QVector<Zone> zones;
+    zones.reserve(systemTimeZones.size());
+
+    for (const QByteArray &id : systemTimeZones) {
+        const QTimeZone zone(id);
+        const QString zoneId = QString::fromUtf8(id);
+        const QString city = zoneId.mid(zoneId.lastIndexOf(QLatin1Char('/')) + 1);
+        const QString continent = zoneId.left(zoneId.indexOf(QLatin1Char('/')));
+
+        zones.append({zone, city, continent, city + QLatin1Char('|') + QLocale::countryToString(zone.country()) + QLatin1Char('|') + continent});
+    }
+
+    std::sort(zones.begin(), zones.end(), [](const Zone &a, const Zone &b) {
+        return a.sortKey.compare(b.sortKey, Qt::CaseInsensitive) < 0;
+    });
+
+    m_timeZones.reserve(zones.size());
+
+    for (const Zone &zone : qAsConst(zones)) {
+        QString comment = zone.zone.comment();
+
+        if (!comment.isEmpty()) {
+            comment = i18n(comment.toUtf8());
+        }
+
+        TimeZoneData data;
+        data.id = QString::fromUtf8(zone.zone.id());
+        data.region = zone.zone.country() == QLocale::AnyCountry
+            ? QString()
+            : m_timezonesI18n.i18nContinents(zone.continent) + QLatin1Char('/') + m_timezonesI18n.i18nCountry(zone.zone.country());
+        data.city = m_timezonesI18n.i18nCity(zone.city);
+        data.comment = comment;
+        data.searchKey = searchKey(data);
+        m_timeZones.append(data);
+    }
+}
+
+TimeZoneData TimeZoneCatalog::localTimeZone()
+{
+    const QString systemId = QString::fromUtf8(QTimeZone::systemTimeZoneId());
+
+    TimeZoneData local;
+    local.isLocalTimeZone = true;
+    local.id = QStringLiteral("Local");
+    local.region = i18nc("This means \"Local Timezone\"", "Local");
+    local.city = m_timezonesI18n.i18nCity(systemId.mid(systemId.lastIndexOf(QLatin1Char('/')) + 1));
+    local.comment = i18n("System's local time zone");
+    local.searchKey = searchKey(local);
+
+    return local;
+}
+
+int TimeZoneCatalog::offsetFromUtc(const QString &id) const
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    auto it = m_offsets.constFind(id);
+    if (it != m_offsets.constEnd() && now < it->validUntil) {
+        return it->offsetFromUtc;
+    }
+
+    const QTimeZone zone(id.toUtf8());
+    if (!zone.isValid()) {
+        return 0;
+    }
+
+    const QDateTime currentDateTime = QDateTime::fromMSecsSinceEpoch(now, Qt::UTC);
+
+    Offset offset;
+    offset.offsetFromUtc = zone.offsetFromUtc(currentDateTime);
+    if (zone.hasTransitions()) {
+        const QDateTime nextTransition = zone.nextTransition(currentDateTime).atUtc;
+        offset.validUntil = nextTransition.isValid() ? nextTransition.toMSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+    } else {
+        offset.validUntil = now + s_offsetFallbackValidity;
+    }
+
+    m_offsets.insert(id, offset);
+    return offset.offsetFromUtc;
+}
+
+QString TimeZoneCatalog::searchKey(const TimeZoneData &data)
+{
+    // separated by a newline so that a filter cannot match across fields
+    return (data.city + QLatin1Char('\n') + data.region + QLatin1Char('\n') + data.comment).toCaseFolded();
+}
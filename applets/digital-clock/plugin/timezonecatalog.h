@@ -0,0 +1,58 @@
+/*
+    SPDX-FileCopyrightText: 2014 Kai Uwe Broulik <kde@privat.broulik.de>
+    SPDX-FileCopyrightText: 2014 Martin Klapetek <mklapetek@kde.org>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QVector>
+
+#include "timezonedata.h"
+#include "timezonesi18n.h"
+
+/**
+ * All the time zones known to the system, translated and sorted by city.
+ *
+ * Creating a QTimeZone for each of them and translating their names is expensive,
+ * so it is done once per process, on first use, and shared by all the TimeZoneModels.
+ * Only to be used from the GUI thread.
+ */
+class TimeZoneCatalog
+{
+public:
+    TimeZoneCatalog();
+
+    static TimeZoneCatalog *self();
+
+    const QVector<TimeZoneData> &timeZones() const
+    {
+        return m_timeZones;
+    }
+
+    /**
+     * The entry standing for the system time zone, which may change at runtime
+     */
+    TimeZoneData localTimeZone();
+
+    /**
+     * The current offset from UTC in seconds of the time zone @p id, 0 if unknown.
+     * Offsets are cached until the next transition of their time zone.
+     */
+    int offsetFromUtc(const QString &id) const;
+
+    static QString searchKey(const TimeZoneData &data);
+
+private:
+    struct Offset {
+        int offsetFromUtc;
+        qint64 validUntil;
+    };
+
+    QVector<TimeZoneData> m_timeZones;
+    TimezonesI18n m_timezonesI18n;
+    mutable QHash<QString, Offset> m_offsets;
+};
@@ -15,7 +15,7 @@ public:
     QString region;
     QString city;
     QString comment;
-    bool checked = false;
+    // city, region and comment case folded, what the filter matches against
+    QString searchKey;
     bool isLocalTimeZone = false;
-    int offsetFromUtc = 0;
 };
@@ -6,16 +6,13 @@
 */
 
 #include "timezonemodel.h"
-#include "timezonesi18n.h"
+#include "timezonecatalog.h"
 
-#include <KLocalizedString>
 #include <QStringMatcher>
-#include <QTimeZone>
 
 TimeZoneFilterProxy::TimeZoneFilterProxy(QObject *parent)
     : QSortFilterProxyModel(parent)
 {
-    m_stringMatcher.setCaseSensitivity(Qt::CaseInsensitive);
 }
 
 bool TimeZoneFilterProxy::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
@@ -24,26 +21,19 @@ bool TimeZoneFilterProxy::filterAcceptsRow(int source_row, const QModelIndex &so
         return true;
     }
 
-    const bool checked = sourceModel()->index(source_row, 0, source_parent).data(TimeZoneModel::CheckedRole).toBool();
-    if (m_onlyShowChecked && !checked) {
-        return false;
-    }
-
-    const QString city = sourceModel()->index(source_row, 0, source_parent).data(TimeZoneModel::CityRole).toString();
-    const QString region = sourceModel()->index(source_row, 0, source_parent).data(TimeZoneModel::RegionRole).toString();
-    const QString comment = sourceModel()->index(source_row, 0, source_parent).data(TimeZoneModel::CommentRole).toString();
+    const QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
 
-    if (m_stringMatcher.indexIn(city) != -1 || m_stringMatcher.indexIn(region) != -1 || m_stringMatcher.indexIn(comment) != -1) {
-        return true;
+    if (m_onlyShowChecked && !index.data(TimeZoneModel::CheckedRole).toBool()) {
+        return false;
     }
 
-    return false;
+    return m_filterString.isEmpty() || m_stringMatcher.indexIn(index.data(TimeZoneModel::SearchKeyRole).toString()) != -1;
 }
 
 void TimeZoneFilterProxy::setFilterString(const QString &filterString)
 {
     m_filterString = filterString;
-    m_stringMatcher.setPattern(filterString);
+    m_stringMatcher.setPattern(filterString.toCaseFolded());
     Q_EMIT filterStringChanged();
     invalidateFilter();
 }
@@ -61,7 +51,6 @@ void TimeZoneFilterProxy::setOnlyShowChecked(const bool show)
 
 TimeZoneModel::TimeZoneModel(QObject *parent)
     : QAbstractListModel(parent)
-    , m_timezonesI18n(new TimezonesI18n(this))
 {
     update();
 }
@@ -73,13 +62,13 @@ TimeZoneModel::~TimeZoneModel()
 int TimeZoneModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent);
-    return m_data.count();
+    return m_checked.count();
 }
 
 QVariant TimeZoneModel::data(const QModelIndex &index, int role) const
 {
     if (index.isValid()) {
-        TimeZoneData currentData = m_data.at(index.row());
+        const TimeZoneData &currentData = timeZoneAt(index.row());
 
         switch (role) {
         case TimeZoneIdRole:
@@ -91,9 +80,11 @@ QVariant TimeZoneModel::data(const QModelIndex &index, int role) const
         case CommentRole:
             return currentData.comment;
         case CheckedRole:
-            return currentData.checked;
+            return m_checked.at(index.row());
         case IsLocalTimeZoneRole:
             return currentData.isLocalTimeZone;
+        case SearchKeyRole:
+            return currentData.searchKey;
         }
     }
 
@@ -107,15 +98,13 @@ bool TimeZoneModel::setData(const QModelIndex &index, const QVariant &value, int
     }
 
     if (role == CheckedRole) {
-        m_data[index.row()].checked = value.toBool();
+        m_checked[index.row()] = value.toBool();
         Q_EMIT dataChanged(index, index);
 
-        if (m_data[index.row()].checked) {
-            m_selectedTimeZones.append(m_data[index.row()].id);
-            m_offsetData.insert(m_data[index.row()].id, m_data[index.row()].offsetFromUtc);
+        if (m_checked.at(index.row())) {
+            m_selectedTimeZones.append(timeZoneAt(index.row()).id);
         } else {
-            m_selectedTimeZones.removeAll(m_data[index.row()].id);
-            m_offsetData.remove(m_data[index.row()].id);
+            m_selectedTimeZones.removeAll(timeZoneAt(index.row()).id);
         }
 
         sortTimeZones();
@@ -130,60 +119,9 @@ bool TimeZoneModel::setData(const QModelIndex &index, const QVariant &value, int
 void TimeZoneModel::update()
 {
     beginResetModel();
-    m_data.clear();
-
-    QTimeZone localZone = QTimeZone(QTimeZone::systemTimeZoneId());
-    const QStringList data = QString::fromUtf8(localZone.id()).split(QLatin1Char('/'));
-
-    TimeZoneData local;
-    local.isLocalTimeZone = true;
-    local.id = QStringLiteral("Local");
-    local.region = i18nc("This means \"Local Timezone\"", "Local");
-    local.city = m_timezonesI18n->i18nCity(data.last());
-    local.comment = i18n("System's local time zone");
-    local.checked = false;
-
-    m_data.append(local);
-
-    QStringList cities;
-    QHash<QString, QTimeZone> zonesByCity;
-
-    const QList<QByteArray> systemTimeZones = QTimeZone::availableTimeZoneIds();
 
-    for (auto it = systemTimeZones.constBegin(); it != systemTimeZones.constEnd(); ++it) {
-        const QTimeZone zone(*it);
-        const QStringList splitted = QString::fromUtf8(zone.id()).split(QStringLiteral("/"));
-
-        // CITY | COUNTRY | CONTINENT
-        const QString key = QStringLiteral("%1|%2|%3").arg(splitted.last(), QLocale::countryToString(zone.country()), splitted.first());
-
-        cities.append(key);
-        zonesByCity.insert(key, zone);
-    }
-    cities.sort(Qt::CaseInsensitive);
-
-    for (const QString &key : qAsConst(cities)) {
-        const QTimeZone timeZone = zonesByCity.value(key);
-        QString comment = timeZone.comment();
-
-        if (!comment.isEmpty()) {
-            comment = i18n(comment.toUtf8());
-        }
-
-        const QStringList cityCountryContinent = key.split(QLatin1Char('|'));
-
-        TimeZoneData newData;
-        newData.isLocalTimeZone = false;
-        newData.id = timeZone.id();
-        newData.region = timeZone.country() == QLocale::AnyCountry
-            ? QString()
-            : m_timezonesI18n->i18nContinents(cityCountryContinent.at(2)) + QLatin1Char('/') + m_timezonesI18n->i18nCountry(timeZone.country());
-        newData.city = m_timezonesI18n->i18nCity(cityCountryContinent.at(0));
-        newData.comment = comment;
-        newData.checked = false;
-        newData.offsetFromUtc = timeZone.offsetFromUtc(QDateTime::currentDateTimeUtc());
-        m_data.append(newData);
-    }
+    m_localTimeZone = TimeZoneCatalog::self()->localTimeZone();
+    m_checked.fill(false, TimeZoneCatalog::self()->timeZones().count() + 1);
 
     endResetModel();
 }
@@ -191,10 +129,9 @@ void TimeZoneModel::update()
 void TimeZoneModel::setSelectedTimeZones(const QStringList &selectedTimeZones)
 {
     m_selectedTimeZones = selectedTimeZones;
-    for (int i = 0; i < m_data.size(); i++) {
-        if (m_selectedTimeZones.contains(m_data.at(i).id)) {
-            m_data[i].checked = true;
-            m_offsetData.insert(m_data[i].id, m_data[i].offsetFromUtc);
+    for (int i = 0; i < m_checked.size(); i++) {
+        if (m_selectedTimeZones.contains(timeZoneAt(i).id)) {
+            m_checked[i] = true;
 
             QModelIndex index = createIndex(i, 0);
             Q_EMIT dataChanged(index, index);
@@ -206,12 +143,12 @@ void TimeZoneModel::setSelectedTimeZones(const QStringList &selectedTimeZones)
 
 void TimeZoneModel::selectLocalTimeZone()
 {
-    m_data[0].checked = true;
+    m_checked[0] = true;
 
     QModelIndex index = createIndex(0, 0);
     Q_EMIT dataChanged(index, index);
 
-    m_selectedTimeZones << m_data[0].id;
+    m_selectedTimeZones << m_localTimeZone.id;
     Q_EMIT selectedTimeZonesChanged();
 }
 
@@ -229,7 +166,13 @@ QHash<int, QByteArray> TimeZoneModel::roleNames() const
 
 void TimeZoneModel::sortTimeZones()
 {
-    std::sort(m_selectedTimeZones.begin(), m_selectedTimeZones.end(), [this](const QString &a, const QString &b) {
-        return m_offsetData.value(a) < m_offsetData.value(b);
+    const TimeZoneCatalog *catalog = TimeZoneCatalog::self();
+    std::sort(m_selectedTimeZones.begin(), m_selectedTimeZones.end(), [catalog](const QString &a, const QString &b) {
+        return catalog->offsetFromUtc(a) < catalog->offsetFromUtc(b);
     });
 }
+
+const TimeZoneData &TimeZoneModel::timeZoneAt(int row) const
+{
+    return row == 0 ? m_localTimeZone : TimeZoneCatalog::self()->timeZones().at(row - 1);
+}
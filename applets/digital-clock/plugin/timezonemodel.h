@@ -12,8 +12,6 @@
 
 #include "timezonedata.h"
 
-class TimezonesI18n;
-
 class TimeZoneFilterProxy : public QSortFilterProxyModel
 {
     Q_OBJECT
@@ -34,6 +32,7 @@ Q_SIGNALS:
 private:
     QString m_filterString;
     bool m_onlyShowChecked = false;
+    // matches against case folded search keys
     QStringMatcher m_stringMatcher;
 };
 
@@ -55,6 +54,7 @@ public:
         CommentRole,
         CheckedRole,
         IsLocalTimeZoneRole,
+        SearchKeyRole,
     };
 
     int rowCount(const QModelIndex &parent) const override;
@@ -74,9 +74,10 @@ protected:
 
 private:
     void sortTimeZones();
+    const TimeZoneData &timeZoneAt(int row) const;
 
-    QList<TimeZoneData> m_data;
-    QHash<QString, int> m_offsetData; // used for sorting
+    // The system time zone comes first, followed by the ones of the shared TimeZoneCatalog
+    TimeZoneData m_localTimeZone;
+    QVector<bool> m_checked;
     QStringList m_selectedTimeZones;
-    TimezonesI18n *m_timezonesI18n;
 };
@@ -32,6 +32,8 @@ PlasmaExtras.Representation {
     readonly property int controlSize: PlasmaCore.Units.iconSizes.medium
 
     property double position: (mpris2Source.currentData && mpris2Source.currentData.Position) || 0
+    // when the position above was known, it moves on from there at the rate below while playing
+    readonly property date positionUpdated: (mpris2Source.currentData && mpris2Source.currentData["Position last updated (UTC)"]) || new Date()
     readonly property real rate: (mpris2Source.currentData && mpris2Source.currentData.Rate) || 1
     readonly property double length: currentMetadata ? currentMetadata["mpris:length"] || 0 : 0
     readonly property bool canSeek: (mpris2Source.currentData && mpris2Source.currentData.CanSeek) || false
@@ -43,6 +45,18 @@ PlasmaExtras.Representation {
     property bool disablePositionUpdate: false
     property bool keyPressed: false
 
+    function extrapolatedPosition() {
+        var extrapolated = position;
+        if (root.state === "playing") {
+            // position is in microseconds
+            extrapolated += (Date.now() - positionUpdated.getTime()) * 1000 * rate;
+        }
+        if (length > 0) {
+            extrapolated = Math.min(extrapolated, length);
+        }
+        return Math.max(0, extrapolated);
+    }
+
     function retrievePosition() {
         var service = mpris2Source.serviceForSource(mpris2Source.current);
         var operation = service.operationDescription("GetPosition");
@@ -65,7 +79,7 @@ PlasmaExtras.Representation {
             disablePositionUpdate = true
             // Slider refuses to set value beyond its end, make sure "to" is up-to-date first
             seekSlider.to = length;
-            seekSlider.value = position
+            seekSlider.value = extrapolatedPosition()
             disablePositionUpdate = false
         }
     }
@@ -572,15 +586,11 @@ PlasmaExtras.Representation {
                         repeat: true
                         running: root.state === "playing" && Plasmoid.expanded && !keyPressed && interval > 0 && seekSlider.to >= 1000000
                         onTriggered: {
-                            // some players don't continuously update the seek slider position via mpris
-                            // add one second; value in microseconds
+                            // players don't continuously update the position via mpris,
+                            // it moves on from the last known one
                             if (!seekSlider.pressed) {
                                 disablePositionUpdate = true
-                                if (seekSlider.value == seekSlider.to) {
-                                    retrievePosition();
-                                } else {
-                                    seekSlider.value += 1000000
-                                }
+                                seekSlider.value = extrapolatedPosition()
                                 disablePositionUpdate = false
                             }
                         }
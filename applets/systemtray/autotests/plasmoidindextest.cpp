@@ -0,0 +1,97 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QtTest>
+
+#include "../plasmoidindex.h"
+
+class PlasmoidIndexTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void testPackageInstalled();
+
+private:
+    static QString packageRoot();
+    static void installPackage(const QString &pluginId);
+    static bool contains(const QList<KPluginMetaData> &applets, const QString &pluginId);
+};
+
+QString PlasmoidIndexTest::packageRoot()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QStringLiteral("/plasma/plasmoids");
+}
+
+void PlasmoidIndexTest::installPackage(const QString &pluginId)
+{
+    const QString folder = packageRoot() + QLatin1Char('/') + pluginId;
+    QVERIFY(QDir().mkpath(folder + QStringLiteral("/contents/ui")));
+
+    const QJsonObject metaData{
+        {QStringLiteral("KPlugin"),
+         QJsonObject{
+             {QStringLiteral("Id"), pluginId},
+             {QStringLiteral("Name"), pluginId},
+             {QStringLiteral("ServiceTypes"), QJsonArray{QStringLiteral("Plasma/Applet")}},
+         }},
+        {QStringLiteral("KPackageStructure"), QStringLiteral("Plasma/Applet")},
+        {QStringLiteral("X-Plasma-NotificationArea"), QStringLiteral("true")},
+    };
+
+    QFile file(folder + QStringLiteral("/metadata.json"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QJsonDocument(metaData).toJson());
+}
+
+bool PlasmoidIndexTest::contains(const QList<KPluginMetaData> &applets, const QString &pluginId)
+{
+    return std::any_of(applets.cbegin(), applets.cend(), [&pluginId](const KPluginMetaData &applet) {
+        return applet.pluginId() == pluginId;
+    });
+}
+
+void PlasmoidIndexTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    cleanupTestCase();
+}
+
+void PlasmoidIndexTest::cleanupTestCase()
+{
+    QDir(packageRoot()).removeRecursively();
+    QFile::remove(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/plasma-systemtray-applets.json"));
+}
+
+void PlasmoidIndexTest::testPackageInstalled()
+{
+    installPackage(QStringLiteral("org.kde.plasma.first.test"));
+    QVERIFY(contains(PlasmoidIndex::self()->systemTrayApplets(), QStringLiteral("org.kde.plasma.first.test")));
+
+    // what PlasmoidRegistry does when a package got installed, before the catalog noticed it on its own
+    installPackage(QStringLiteral("org.kde.plasma.second.test"));
+    PlasmoidIndex::self()->invalidate();
+
+    QList<KPluginMetaData> applets = PlasmoidIndex::self()->systemTrayApplets();
+    QVERIFY(contains(applets, QStringLiteral("org.kde.plasma.first.test")));
+    QVERIFY(contains(applets, QStringLiteral("org.kde.plasma.second.test")));
+
+    // nothing changed on disk since, so this comes from the saved index, like on the next start
+    PlasmoidIndex::self()->invalidate();
+    applets = PlasmoidIndex::self()->systemTrayApplets();
+    QVERIFY(contains(applets, QStringLiteral("org.kde.plasma.second.test")));
+}
+
+QTEST_MAIN(PlasmoidIndexTest)
+
+#include "plasmoidindextest.moc"
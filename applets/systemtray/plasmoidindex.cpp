@@ -0,0 +1,190 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "plasmoidindex.h"
+#include "debug.h"
+
+#include <appletmetadatacatalog.h>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+// bump whenever the layout of the cache file changes
+constexpr int s_indexVersion = 2;
+}
+
+Q_GLOBAL_STATIC(PlasmoidIndex, s_plasmoidIndex)
+
+PlasmoidIndex *PlasmoidIndex::self()
+{
+    return s_plasmoidIndex;
+}
+
+QList<KPluginMetaData> PlasmoidIndex::systemTrayApplets()
+{
+    if (!m_valid) {
+        const QHash<QString, qint64> timeStamps = currentTimeStamps();
+        if (!load(timeStamps)) {
+            m_timeStamps = timeStamps;
+            rebuild();
+            save();
+        }
+        m_valid = true;
+    }
+
+    return m_applets;
+}
+
+void PlasmoidIndex::invalidate()
+{
+    // the catalog might not have noticed the change yet, then the rebuilt index would miss it
+    AppletMetaDataCatalog::self()->invalidate();
+
+    m_valid = false;
+    m_timeStamps.clear();
+    m_applets.clear();
+}
+
+bool PlasmoidIndex::load(const QHash<QString, qint64> &timeStamps)
+{
+    QFile file(cacheFileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject index = QJsonDocument::fromJson(file.readAll()).object();
+    if (index.value(QStringLiteral("version")).toInt() != s_indexVersion) {
+        return false;
+    }
+
+    const QJsonObject storedTimeStamps = index.value(QStringLiteral("timeStamps")).toObject();
+    if (storedTimeStamps.size() != timeStamps.size()) {
+        return false;
+    }
+    for (auto it = timeStamps.cbegin(); it != timeStamps.cend(); ++it) {
+        if (storedTimeStamps.value(it.key()).toVariant().toLongLong() != it.value()) {
+            return false;
+        }
+    }
+
+    QList<KPluginMetaData> applets;
+    const QJsonArray storedApplets = index.value(QStringLiteral("applets")).toArray();
+    for (const QJsonValue &value : storedApplets) {
+        const QJsonObject applet = value.toObject();
+        KPluginMetaData metaData(applet.value(QStringLiteral("metaData")).toObject(), applet.value(QStringLiteral("fileName")).toString());
+        if (!metaData.isValid()) {
+            return false;
+        }
+        applets << metaData;
+    }
+
+    qCDebug(SYSTEM_TRAY) << "Using cached index of" << applets.size() << "system tray applets";
+    m_timeStamps = timeStamps;
+    m_applets = applets;
+    return true;
+}
+
+void PlasmoidIndex::save() const
+{
+    QJsonObject timeStamps;
+    for (auto it = m_timeStamps.cbegin(); it != m_timeStamps.cend(); ++it) {
+        timeStamps.insert(it.key(), QString::number(it.value()));
+    }
+
+    QJsonArray applets;
+    for (const KPluginMetaData &metaData : qAsConst(m_applets)) {
+        applets.append(QJsonObject{
+            {QStringLiteral("fileName"), metaData.fileName()},
+            {QStringLiteral("metaData"), metaData.rawData()},
+        });
+    }
+
+    const QJsonObject index{
+        {QStringLiteral("version"), s_indexVersion},
+        {QStringLiteral("timeStamps"), timeStamps},
+        {QStringLiteral("applets"), applets},
+    };
+
+    const QString fileName = cacheFileName();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(SYSTEM_TRAY) << "Failed to write system tray applet index" << fileName << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(index).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+void PlasmoidIndex::rebuild()
+{
+    qCDebug(SYSTEM_TRAY) << "Rebuilding index of system tray applets";
+
+    m_applets.clear();
+    for (const auto &info : AppletMetaDataCatalog::self()->applets()) {
+        if (info.isValid() && info.value(QStringLiteral("X-Plasma-NotificationArea")) == QLatin1String("true")) {
+            m_applets << info;
+        }
+    }
+}
+
+QHash<QString, qint64> PlasmoidIndex::currentTimeStamps()
+{
+    QHash<QString, qint64> timeStamps;
+
+    auto addTimeStamp = [&timeStamps](const QFileInfo &info) {
+        timeStamps.insert(info.absoluteFilePath(), info.lastModified().toMSecsSinceEpoch());
+    };
+
+    // installing, updating or removing a package replaces files within its folder, which
+    // touches the package folder; adding or removing packages touches the root folder
+    const QStringList packageRoots =
+        QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, QStringLiteral("plasma/plasmoids"), QStandardPaths::LocateDirectory);
+    for (const QString &root : packageRoots) {
+        addTimeStamp(QFileInfo(root));
+        QDirIterator it(root, QDir::Dirs | QDir::NoDotAndDotDot);
+        while (it.hasNext()) {
+            it.next();
+            addTimeStamp(it.fileInfo());
+
+            // the metadata can also be edited in place, which leaves the folder alone
+            for (const QString &metaDataFile : {QStringLiteral("/metadata.json"), QStringLiteral("/metadata.desktop")}) {
+                const QFileInfo metaDataInfo(it.filePath() + metaDataFile);
+                if (metaDataInfo.exists()) {
+                    addTimeStamp(metaDataInfo);
+                }
+            }
+        }
+    }
+
+    // applets with compiled in metadata
+    const QStringList libraryPaths = QCoreApplication::libraryPaths();
+    for (const QString &libraryPath : libraryPaths) {
+        const QFileInfo info(libraryPath + QStringLiteral("/plasma/applets"));
+        if (info.isDir()) {
+            addTimeStamp(info);
+        }
+    }
+
+    return timeStamps;
+}
+
+QString PlasmoidIndex::cacheFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/plasma-systemtray-applets.json");
+}
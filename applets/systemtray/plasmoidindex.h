@@ -0,0 +1,49 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include <KPluginMetaData>
+
+/**
+ * @brief Persistent index of the applets that want to live in the notification area.
+ *
+ * Finding those applets means listing and parsing the metadata of every applet on the system.
+ * The result is kept in memory, shared by all system tray instances of the process, and on disk
+ * in the cache folder. The on-disk index is only trusted as long as the modification times of
+ * the applet folders and metadata files it was built from did not change.
+ */
+class PlasmoidIndex
+{
+public:
+    static PlasmoidIndex *self();
+
+    /**
+     * @return metadata of all applets having X-Plasma-NotificationArea set
+     */
+    QList<KPluginMetaData> systemTrayApplets();
+
+    /**
+     * Drop the index, it is rebuilt on the next call to systemTrayApplets()
+     * Call this when a package has been installed, updated or removed.
+     */
+    void invalidate();
+
+private:
+    bool load(const QHash<QString, qint64> &timeStamps);
+    void save() const;
+    void rebuild();
+    static QHash<QString, qint64> currentTimeStamps();
+    static QString cacheFileName();
+
+    bool m_valid = false;
+    QHash<QString /*folder or metadata file*/, qint64 /*mtime*/> m_timeStamps;
+    QList<KPluginMetaData> m_applets;
+};
@@ -9,10 +9,10 @@
 #include "debug.h"
 
 #include "dbusserviceobserver.h"
+#include "plasmoidindex.h"
 #include "systemtraysettings.h"
 
 #include <KPluginMetaData>
-#include <Plasma/PluginLoader>
 
 #include <QDBusConnection>
 
@@ -48,7 +48,7 @@ void PlasmoidRegistry::init()
 
     connect(m_settings, &SystemTraySettings::enabledPluginsChanged, this, &PlasmoidRegistry::onEnabledPluginsChanged);
 
-    for (const auto &info : Plasma::PluginLoader::self()->listAppletMetaData(QString())) {
+    for (const auto &info : PlasmoidIndex::self()->systemTrayApplets()) {
         registerPlugin(info);
     }
 
@@ -85,6 +85,8 @@ void PlasmoidRegistry::packageInstalled(const QString &pluginId)
 {
     qCDebug(SYSTEM_TRAY) << "New package installed" << pluginId;
 
+    PlasmoidIndex::self()->invalidate();
+
     if (m_systrayApplets.contains(pluginId)) {
         if (m_settings->isEnabledPlugin(pluginId) && !m_dbusObserver->isDBusActivable(pluginId)) {
             // restart plasmoid
@@ -94,7 +96,7 @@ void PlasmoidRegistry::packageInstalled(const QString &pluginId)
         return;
     }
 
-    for (const auto &info : Plasma::PluginLoader::self()->listAppletMetaData(QString())) {
+    for (const auto &info : PlasmoidIndex::self()->systemTrayApplets()) {
         if (info.pluginId() == pluginId) {
             registerPlugin(info);
         }
@@ -104,6 +106,7 @@ void PlasmoidRegistry::packageInstalled(const QString &pluginId)
 void PlasmoidRegistry::packageUninstalled(const QString &pluginId)
 {
     qCDebug(SYSTEM_TRAY) << "Package uninstalled" << pluginId;
+    PlasmoidIndex::self()->invalidate();
     if (m_systrayApplets.contains(pluginId)) {
         unregisterPlugin(pluginId);
     }
@@ -188,8 +188,10 @@ Plasma::Service *StatusNotifierItemSource::createService()
 
 void StatusNotifierItemSource::syncStatus(const QString &status)
 {
-    m_status = status;
-    Q_EMIT dataUpdated();
+    if (m_status != status) {
+        m_status = status;
+        Q_EMIT dataUpdated(Property::Status);
+    }
 }
 
 void StatusNotifierItemSource::refreshMenu()
@@ -240,9 +242,19 @@ void StatusNotifierItemSource::refreshCallback(QDBusPendingCallWatcher *call)
         return;
     }
 
+    Properties changed;
+    auto update = [&changed](auto &member, const auto &value, Property property) {
+        if (member != value) {
+            member = value;
+            changed |= property;
+        }
+    };
+
     QDBusPendingReply<QVariantMap> reply = *call;
     if (reply.isError()) {
+        // consumers have to stop relying on what they got so far
         m_valid = false;
+        changed = Property::All;
     } else {
         // IconThemePath (handle this one first, because it has an impact on
         // others)
@@ -272,31 +284,45 @@ void StatusNotifierItemSource::refreshCallback(QDBusPendingCallWatcher *call)
                 m_customIconLoader->addAppDir(appName.size() ? appName : QStringLiteral("unused"), path);
             });
         }
-        m_iconThemePath = path;
+        if (m_iconThemePath != path) {
+            // named icons may now resolve to different images
+            m_iconThemePath = path;
+            changed |= Property::IconThemePath | Property::Icon | Property::AttentionIcon;
+        }
 
-        m_category = properties[QStringLiteral("Category")].toString();
-        m_status = properties[QStringLiteral("Status")].toString();
-        m_title = properties[QStringLiteral("Title")].toString();
-        m_id = properties[QStringLiteral("Id")].toString();
-        m_windowId = properties[QStringLiteral("WindowId")].toString();
-        m_itemIsMenu = properties[QStringLiteral("ItemIsMenu")].toBool();
+        update(m_category, properties[QStringLiteral("Category")].toString(), Property::Category);
+        update(m_status, properties[QStringLiteral("Status")].toString(), Property::Status);
+        update(m_title, properties[QStringLiteral("Title")].toString(), Property::Title);
+        update(m_id, properties[QStringLiteral("Id")].toString(), Property::Id);
+        update(m_windowId, properties[QStringLiteral("WindowId")].toString(), Property::WindowId);
+        update(m_itemIsMenu, properties[QStringLiteral("ItemIsMenu")].toBool(), Property::ItemIsMenu);
 
         // Attention Movie
-        m_attentionMovieName = properties[QStringLiteral("AttentionMovieName")].toString();
+        update(m_attentionMovieName, properties[QStringLiteral("AttentionMovieName")].toString(), Property::AttentionMovieName);
 
         QIcon overlay;
         QStringList overlayNames;
+        uint overlayKey = 0;
+
+        auto imageKey = [](const KDbusImageVector &image) {
+            uint key = 0;
+            for (const KDbusImageStruct &size : image) {
+                key ^= qHash(size.data, uint(size.width) << 16 | uint(size.height));
+            }
+            return key;
+        };
 
         // Overlay icon
         {
-            m_overlayIconName = QString();
+            QString overlayIconName;
 
             const QString iconName = properties[QStringLiteral("OverlayIconName")].toString();
             if (!iconName.isEmpty()) {
                 overlay = QIcon(new KIconEngine(iconName, iconLoader()));
                 if (!overlay.isNull()) {
-                    m_overlayIconName = iconName;
+                    overlayIconName = iconName;
                     overlayNames << iconName;
+                    overlayKey = qHash(iconName);
                 }
             }
             if (overlay.isNull()) {
@@ -304,11 +330,14 @@ void StatusNotifierItemSource::refreshCallback(QDBusPendingCallWatcher *call)
                 properties[QStringLiteral("OverlayIconPixmap")].value<QDBusArgument>() >> image;
                 if (!image.isEmpty()) {
                     overlay = imageVectorToPixmap(image);
+                    overlayKey = imageKey(image);
                 }
             }
+            update(m_overlayIconName, overlayIconName, Property::OverlayIconName);
         }
 
-        auto loadIcon = [this, &properties, &overlay, &overlayNames](const QString &iconKey, const QString &pixmapKey) -> std::tuple<QIcon, QString> {
+        auto loadIcon = [this, &properties, &overlay, &overlayNames, overlayKey, &imageKey](const QString &iconKey,
+                                                                                           const QString &pixmapKey) -> std::tuple<QIcon, QString, uint> {
             const QString iconName = properties[iconKey].toString();
             if (!iconName.isEmpty()) {
                 QIcon icon = QIcon(new KIconEngine(iconName, iconLoader(), overlayNames));
@@ -316,7 +345,7 @@ void StatusNotifierItemSource::refreshCallback(QDBusPendingCallWatcher *call)
                     if (!overlay.isNull() && overlayNames.isEmpty()) {
                         overlayIcon(&icon, &overlay);
                     }
-                    return {icon, iconName};
+                    return {icon, iconName, qHash(iconName, overlayKey)};
                 }
             }
             KDbusImageVector image;
@@ -326,19 +355,39 @@ void StatusNotifierItemSource::refreshCallback(QDBusPendingCallWatcher *call)
                 if (!icon.isNull() && !overlay.isNull()) {
                     overlayIcon(&icon, &overlay);
                 }
-                return {icon, QString()};
+                return {icon, QString(), imageKey(image) ^ overlayKey};
             }
             return {};
         };
 
-        std::tie(m_icon, m_iconName) = loadIcon(QStringLiteral("IconName"), QStringLiteral("IconPixmap"));
-        std::tie(m_attentionIcon, m_attentionIconName) = loadIcon(QStringLiteral("AttentionIconName"), QStringLiteral("AttentionIconPixmap"));
+        auto updateIcon = [&changed](QIcon &icon, QString &iconName, uint &key, const std::tuple<QIcon, QString, uint> &loaded, Property property) {
+            if (icon.isNull() != std::get<0>(loaded).isNull() || iconName != std::get<1>(loaded) || key != std::get<2>(loaded)) {
+                changed |= property;
+            }
+            // always take the new icon, the icon loader might have changed
+            std::tie(icon, iconName, key) = loaded;
+        };
+
+        updateIcon(m_icon, m_iconName, m_iconKey, loadIcon(QStringLiteral("IconName"), QStringLiteral("IconPixmap")), Property::Icon);
+        updateIcon(m_attentionIcon,
+                   m_attentionIconName,
+                   m_attentionIconKey,
+                   loadIcon(QStringLiteral("AttentionIconName"), QStringLiteral("AttentionIconPixmap")),
+                   Property::AttentionIcon);
 
         // ToolTip
         {
             KDbusToolTipStruct toolTip;
             properties[QStringLiteral("ToolTip")].value<QDBusArgument>() >> toolTip;
-            if (toolTip.title.isEmpty()) {
+            // without a title there is no tooltip, and nothing else of it is kept
+            const bool hasToolTip = !toolTip.title.isEmpty();
+            const QString toolTipSubTitle = hasToolTip ? toolTip.subTitle : QString();
+            const uint toolTipIconKey = !hasToolTip ? 0 : toolTip.image.isEmpty() ? qHash(toolTip.icon) : imageKey(toolTip.image);
+            if (m_toolTipTitle != toolTip.title || m_toolTipSubTitle != toolTipSubTitle || m_toolTipIconKey != toolTipIconKey) {
+                m_toolTipIconKey = toolTipIconKey;
+                changed |= Property::ToolTip;
+            }
+            if (!hasToolTip) {
                 m_toolTipTitle = QString();
                 m_toolTipSubTitle = QString();
                 m_toolTipIcon = QString();
@@ -380,7 +429,9 @@ void StatusNotifierItemSource::refreshCallback(QDBusPendingCallWatcher *call)
         }
     }
 
-    Q_EMIT dataUpdated();
+    if (changed) {
+        Q_EMIT dataUpdated(changed);
+    }
     call->deleteLater();
 }
 
@@ -22,6 +22,26 @@ class StatusNotifierItemSource : public QObject
     Q_OBJECT
 
 public:
+    /**
+     * Groups of properties of the item, used to tell which of them changed on a refresh
+     */
+    enum class Property {
+        AttentionIcon = 1 << 0, ///< attentionIcon() and attentionIconName()
+        AttentionMovieName = 1 << 1,
+        Category = 1 << 2,
+        Icon = 1 << 3, ///< icon() and iconName()
+        IconThemePath = 1 << 4,
+        Id = 1 << 5,
+        ItemIsMenu = 1 << 6,
+        OverlayIconName = 1 << 7,
+        Status = 1 << 8,
+        Title = 1 << 9,
+        ToolTip = 1 << 10, ///< toolTipIcon(), toolTipTitle() and toolTipSubTitle()
+        WindowId = 1 << 11,
+        All = (1 << 12) - 1, ///< the item as a whole, for example when it stopped being valid
+    };
+    Q_DECLARE_FLAGS(Properties, Property)
+
     StatusNotifierItemSource(const QString &service, QObject *parent);
     ~StatusNotifierItemSource() override;
     Plasma::Service *createService();
@@ -52,7 +72,7 @@ public:
 Q_SIGNALS:
     void contextMenuReady(QMenu *menu);
     void activateResult(bool success);
-    void dataUpdated();
+    void dataUpdated(StatusNotifierItemSource::Properties changedProperties);
 
 private Q_SLOTS:
     void contextMenuReady();
@@ -86,7 +106,7 @@ private:
     QString m_iconName;
     QString m_iconThemePath;
     QString m_id;
-    bool m_itemIsMenu;
+    bool m_itemIsMenu = false;
     QString m_overlayIconName;
     QString m_status;
     QString m_title;
@@ -94,4 +114,11 @@ private:
     QString m_toolTipSubTitle;
     QString m_toolTipTitle;
     QString m_windowId;
+
+    // identify the images behind m_icon, m_attentionIcon and m_toolTipIcon, to tell whether they changed
+    uint m_iconKey = 0;
+    uint m_attentionIconKey = 0;
+    uint m_toolTipIconKey = 0;
 };
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(StatusNotifierItemSource::Properties)
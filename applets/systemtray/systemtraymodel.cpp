@@ -20,6 +20,8 @@
 #include <QIcon>
 #include <QQuickItem>
 
+#include <utility>
+
 BaseModel::BaseModel(QPointer<SystemTraySettings> settings, QObject *parent)
     : QAbstractListModel(parent)
     , m_settings(settings)
@@ -247,6 +249,10 @@ StatusNotifierModel::StatusNotifierModel(QPointer<SystemTraySettings> settings,
 {
     m_sniHost = StatusNotifierItemHost::self();
 
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(16);
+    connect(&m_updateTimer, &QTimer::timeout, this, &StatusNotifierModel::emitPendingUpdates);
+
     connect(m_sniHost, &StatusNotifierItemHost::itemAdded, this, &StatusNotifierModel::addSource);
     connect(m_sniHost, &StatusNotifierItemHost::itemRemoved, this, &StatusNotifierModel::removeSource);
 
@@ -411,11 +417,12 @@ void StatusNotifierModel::addSource(const QString &source)
     item.source = source;
 
     StatusNotifierItemSource *sni = m_sniHost->itemForService(source);
-    connect(sni, &StatusNotifierItemSource::dataUpdated, this, [=]() {
-        dataUpdated(source);
+    connect(sni, &StatusNotifierItemSource::dataUpdated, this, [=](StatusNotifierItemSource::Properties changedProperties) {
+        dataUpdated(source, changedProperties);
     });
     item.service = sni->createService();
     m_items.append(item);
+    m_sourceIndexes.insert(source, count);
     endInsertRows();
 }
 
@@ -426,27 +433,95 @@ void StatusNotifierModel::removeSource(const QString &source)
         beginRemoveRows(QModelIndex(), idx, idx);
         delete m_items[idx].service;
         m_items.removeAt(idx);
+        m_sourceIndexes.remove(source);
+        m_pendingUpdates.remove(source);
+        rebuildSourceIndexes(idx);
         endRemoveRows();
     }
 }
 
-void StatusNotifierModel::dataUpdated(const QString &sourceName)
+void StatusNotifierModel::dataUpdated(const QString &sourceName, StatusNotifierItemSource::Properties changedProperties)
 {
-    int idx = indexOfSource(sourceName);
+    if (!m_sourceIndexes.contains(sourceName)) {
+        return;
+    }
 
-    if (idx >= 0) {
-        Q_EMIT dataChanged(index(idx, 0), index(idx, 0));
+    m_pendingUpdates[sourceName] |= changedProperties;
+    if (!m_updateTimer.isActive()) {
+        m_updateTimer.start();
     }
 }
 
-int StatusNotifierModel::indexOfSource(const QString &source) const
+void StatusNotifierModel::emitPendingUpdates()
 {
-    for (int i = 0; i < rowCount(); i++) {
-        if (m_items[i].source == source) {
-            return i;
+    const auto pendingUpdates = std::exchange(m_pendingUpdates, {});
+
+    for (auto it = pendingUpdates.cbegin(); it != pendingUpdates.cend(); ++it) {
+        const int idx = indexOfSource(it.key());
+        if (idx >= 0) {
+            Q_EMIT dataChanged(index(idx, 0), index(idx, 0), rolesForProperties(it.value()));
         }
     }
-    return -1;
+}
+
+QVector<int> StatusNotifierModel::rolesForProperties(StatusNotifierItemSource::Properties properties)
+{
+    using Property = StatusNotifierItemSource::Property;
+
+    QVector<int> roles;
+    if (properties & Property::AttentionIcon) {
+        roles << static_cast<int>(Role::AttentionIcon) << static_cast<int>(Role::AttentionIconName);
+    }
+    if (properties & Property::AttentionMovieName) {
+        roles << static_cast<int>(Role::AttentionMovieName);
+    }
+    if (properties & Property::Category) {
+        roles << static_cast<int>(BaseRole::Category) << static_cast<int>(Role::Category);
+    }
+    if (properties & Property::Icon) {
+        roles << Qt::DecorationRole << static_cast<int>(Role::Icon) << static_cast<int>(Role::IconName);
+    }
+    if (properties & Property::IconThemePath) {
+        roles << static_cast<int>(Role::IconThemePath);
+    }
+    if (properties & Property::Id) {
+        // the effective status depends on the item id through the shown/hidden items settings
+        roles << static_cast<int>(BaseRole::ItemId) << static_cast<int>(Role::Id) << static_cast<int>(BaseRole::EffectiveStatus);
+    }
+    if (properties & Property::ItemIsMenu) {
+        roles << static_cast<int>(Role::ItemIsMenu);
+    }
+    if (properties & Property::OverlayIconName) {
+        roles << static_cast<int>(Role::OverlayIconName);
+    }
+    if (properties & Property::Status) {
+        roles << static_cast<int>(BaseRole::Status) << static_cast<int>(Role::Status);
+        if (!(properties & Property::Id)) {
+            roles << static_cast<int>(BaseRole::EffectiveStatus);
+        }
+    }
+    if (properties & Property::Title) {
+        roles << Qt::DisplayRole << static_cast<int>(Role::Title);
+    }
+    if (properties & Property::ToolTip) {
+        roles << static_cast<int>(Role::ToolTipTitle) << static_cast<int>(Role::ToolTipSubTitle);
+    }
+    if (properties & Property::WindowId) {
+        roles << static_cast<int>(Role::WindowId);
+    }
+    return roles;
+}
+
+void StatusNotifierModel::rebuildSourceIndexes(int from)
+{
+    for (int i = from; i < m_items.size(); ++i) {
+        m_sourceIndexes[m_items[i].source] = i;
+    }
+}
+
+int StatusNotifierModel::indexOfSource(const QString &source) const
+{
+    return m_sourceIndexes.value(source, -1);
 }
 
 SystemTrayModel::SystemTrayModel(QObject *parent)
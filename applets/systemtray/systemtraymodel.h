@@ -10,11 +10,14 @@
 #include <QConcatenateTablesProxyModel>
 #include <QList>
 #include <QPointer>
+#include <QTimer>
 
 #include <KCoreAddons/KPluginMetaData>
 #include <Plasma/Plasma>
 #include <Plasma/Service>
 
+#include "statusnotifieritemsource.h"
+
 namespace Plasma
 {
 class Applet;
@@ -136,7 +139,10 @@ public:
 public Q_SLOTS:
     void addSource(const QString &source);
     void removeSource(const QString &source);
-    void dataUpdated(const QString &sourceName);
+    void dataUpdated(const QString &sourceName, StatusNotifierItemSource::Properties changedProperties);
+
+private Q_SLOTS:
+    void emitPendingUpdates();
 
 public:
     struct Item {
@@ -147,6 +153,15 @@ public:
 
     StatusNotifierItemHost *m_sniHost = nullptr;
     QVector<Item> m_items;
+
+private:
+    static QVector<int> rolesForProperties(StatusNotifierItemSource::Properties properties);
+    void rebuildSourceIndexes(int from);
+
+    QHash<QString /*source*/, int /*row*/> m_sourceIndexes;
+    // changes of many items arriving at once are merged, and reported once per frame
+    QHash<QString /*source*/, StatusNotifierItemSource::Properties> m_pendingUpdates;
+    QTimer m_updateTimer;
 };
 Q_DECLARE_TYPEINFO(StatusNotifierModel::Item, Q_MOVABLE_TYPE);
 
@@ -0,0 +1,177 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QRandomGenerator>
+#include <QSet>
+#include <QtTest>
+
+#include "../gridoccupancy.h"
+
+// A 4K desktop split in 16px cells
+static const int s_rows = 2160 / 16;
+static const int s_columns = 3840 / 16;
+
+class GridOccupancyBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testAgainstCellSet();
+    void benchmarkRelayout();
+    void benchmarkRectQueries();
+    void benchmarkFirstFit();
+
+private:
+    // Places widgets of random sizes left to right, top to bottom, where they first fit
+    static QVector<QRect> firstFitLayout(GridOccupancy &grid, int count);
+};
+
+QVector<QRect> GridOccupancyBenchmark::firstFitLayout(GridOccupancy &grid, int count)
+{
+    QRandomGenerator random(42);
+    QVector<QRect> placed;
+
+    for (int i = 0; i < count; ++i) {
+        const QSize size(random.bounded(4, 24), random.bounded(4, 16));
+        bool found = false;
+
+        for (int row = 0; row <= grid.rows() - size.height() && !found; ++row) {
+            for (int column = grid.nextInRow(row, 0, 1, false); column >= 0 && column <= grid.columns() - size.width();
+                 column = grid.nextInRow(row, column + 1, 1, false)) {
+                const QRect cells(QPoint(column, row), size);
+                if (grid.isFree(cells)) {
+                    grid.setTaken(cells, true);
+                    placed << cells;
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return placed;
+}
+
+void GridOccupancyBenchmark::testAgainstCellSet()
+{
+    QRandomGenerator random(7);
+    const int rows = 37;
+    const int columns = 141;
+
+    GridOccupancy grid;
+    grid.resize(rows, columns);
+    QSet<QPair<int, int>> taken;
+
+    for (int i = 0; i < 2000; ++i) {
+        const QRect cells(random.bounded(-2, columns), random.bounded(-2, rows), random.bounded(0, 80), random.bounded(0, 8));
+
+        if (i % 2) {
+            const bool take = random.bounded(3) > 0;
+            grid.setTaken(cells, take);
+            for (int row = cells.top(); row <= cells.bottom(); ++row) {
+                for (int column = cells.left(); column <= cells.right(); ++column) {
+                    if (row >= 0 && column >= 0 && row < rows && column < columns) {
+                        if (take) {
+                            taken.insert(qMakePair(row, column));
+                        } else {
+                            taken.remove(qMakePair(row, column));
+                        }
+                    }
+                }
+            }
+            continue;
+        }
+
+        bool expectedFree = cells.isEmpty() || QRect(0, 0, columns, rows).contains(cells);
+        for (int row = cells.top(); expectedFree && row <= cells.bottom(); ++row) {
+            for (int column = cells.left(); column <= cells.right(); ++column) {
+                if (taken.contains(qMakePair(row, column))) {
+                    expectedFree = false;
+                    break;
+                }
+            }
+        }
+        // Ask repeatedly, to go through both the bit scan and the summed-area table
+        for (int j = 0; j < 4; ++j) {
+            QCOMPARE(grid.isFree(cells), expectedFree);
+        }
+
+        const int row = random.bounded(rows);
+        const int column = random.bounded(columns);
+        for (int step : {-1, 1}) {
+            for (bool state : {false, true}) {
+                int expected = -1;
+                for (int c = column; c >= 0 && c < columns; c += step) {
+                    if (taken.contains(qMakePair(row, c)) == state) {
+                        expected = c;
+                        break;
+                    }
+                }
+                QCOMPARE(grid.nextInRow(row, column, step, state), expected);
+
+                expected = -1;
+                for (int r = row; r >= 0 && r < rows; r += step) {
+                    if (taken.contains(qMakePair(r, column)) == state) {
+                        expected = r;
+                        break;
+                    }
+                }
+                QCOMPARE(grid.nextInColumn(row, column, step, state), expected);
+            }
+        }
+    }
+}
+
+void GridOccupancyBenchmark::benchmarkRelayout()
+{
+    GridOccupancy grid;
+    grid.resize(s_rows, s_columns);
+    const QVector<QRect> widgets = firstFitLayout(grid, 150);
+    QVERIFY(!widgets.isEmpty());
+
+    // What happens on every resize of the desktop
+    QBENCHMARK {
+        grid.clear();
+        for (const QRect &cells : widgets) {
+            QVERIFY(grid.isFree(cells));
+            grid.setTaken(cells, true);
+        }
+    }
+}
+
+void GridOccupancyBenchmark::benchmarkRectQueries()
+{
+    GridOccupancy grid;
+    grid.resize(s_rows, s_columns);
+    firstFitLayout(grid, 150);
+
+    QRandomGenerator random(3);
+    QVector<QRect> queries;
+    for (int i = 0; i < 10000; ++i) {
+        queries << QRect(random.bounded(s_columns - 24), random.bounded(s_rows - 16), random.bounded(1, 24), random.bounded(1, 16));
+    }
+
+    // What happens while dragging a widget around
+    int free = 0;
+    QBENCHMARK {
+        for (const QRect &cells : qAsConst(queries)) {
+            free += grid.isFree(cells);
+        }
+    }
+    Q_UNUSED(free)
+}
+
+void GridOccupancyBenchmark::benchmarkFirstFit()
+{
+    QBENCHMARK {
+        GridOccupancy grid;
+        grid.resize(s_rows, s_columns);
+        firstFitLayout(grid, 150);
+    }
+}
+
+QTEST_GUILESS_MAIN(GridOccupancyBenchmark)
+
+#include "gridoccupancybenchmark.moc"
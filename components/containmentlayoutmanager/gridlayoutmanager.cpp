@@ -58,7 +58,7 @@ void GridLayoutManager::parseLayout(const QString &savedLayout)
 
 bool GridLayoutManager::itemIsManaged(ItemContainer *item)
 {
-    return m_pointsForItem.contains(item);
+    return m_cellsForItem.contains(item);
 }
 
 inline void maintainItemEdgeAlignment(ItemContainer *item, const QRectF &newRect, const QRectF &oldRect)
@@ -93,8 +93,9 @@ inline void maintainItemEdgeAlignment(ItemContainer *item, const QRectF &newRect
 
 void GridLayoutManager::layoutGeometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
+    m_cellsForItem.clear();
+    syncGridSize();
     m_grid.clear();
-    m_pointsForItem.clear();
     for (auto *item : layout()->childItems()) {
         // Stash the old config
         // m_parsedConfig[item->key()] = {item->x(), item->y(), item->width(), item->height(), item->rotation()};
@@ -111,8 +112,9 @@ void GridLayoutManager::layoutGeometryChanged(const QRectF &newGeometry, const Q
 
 void GridLayoutManager::resetLayout()
 {
+    m_cellsForItem.clear();
+    syncGridSize();
     m_grid.clear();
-    m_pointsForItem.clear();
     for (auto *item : layout()->childItems()) {
         ItemContainer *itemCont = qobject_cast<ItemContainer *>(item);
         if (itemCont && itemCont != layout()->placeHolder()) {
@@ -125,8 +127,9 @@ void GridLayoutManager::resetLayout()
 
 void GridLayoutManager::resetLayoutFromConfig()
 {
+    m_cellsForItem.clear();
+    syncGridSize();
     m_grid.clear();
-    m_pointsForItem.clear();
     QList<ItemContainer *> missingItems;
 
     for (auto *item : layout()->childItems()) {
@@ -176,16 +179,8 @@ bool GridLayoutManager::isRectAvailable(const QRectF &rect)
         return false;
     }
 
-    const QRect cellItemGeom = cellBasedGeometry(rect);
-
-    for (int row = cellItemGeom.top(); row <= cellItemGeom.bottom(); ++row) {
-        for (int column = cellItemGeom.left(); column <= cellItemGeom.right(); ++column) {
-            if (!isCellAvailable(QPair<int, int>(row, column))) {
-                return false;
-            }
-        }
-    }
-    return true;
+    syncGridSize();
+    return m_grid.isFree(cellBasedGeometry(rect));
 }
 
 bool GridLayoutManager::assignSpaceImpl(ItemContainer *item)
@@ -199,13 +194,8 @@ bool GridLayoutManager::assignSpaceImpl(ItemContainer *item)
 
     const QRect cellItemGeom = cellBasedGeometry(itemGeometry(item));
 
-    for (int row = cellItemGeom.top(); row <= cellItemGeom.bottom(); ++row) {
-        for (int column = cellItemGeom.left(); column <= cellItemGeom.right(); ++column) {
-            QPair<int, int> cell(row, column);
-            m_grid.insert(cell, item);
-            m_pointsForItem[item].insert(cell);
-        }
-    }
+    m_grid.setTaken(cellItemGeom, true);
+    m_cellsForItem.insert(item, cellItemGeom);
 
     // Reorder items tab order
     for (auto *i2 : layout()->childItems()) {
@@ -228,17 +218,16 @@ bool GridLayoutManager::assignSpaceImpl(ItemContainer *item)
 
 void GridLayoutManager::releaseSpaceImpl(ItemContainer *item)
 {
-    auto it = m_pointsForItem.find(item);
+    auto it = m_cellsForItem.find(item);
 
-    if (it == m_pointsForItem.end()) {
+    if (it == m_cellsForItem.end()) {
         return;
     }
 
-    for (const auto &point : it.value()) {
-        m_grid.remove(point);
-    }
+    syncGridSize();
+    m_grid.setTaken(it.value(), false);
 
-    m_pointsForItem.erase(it);
+    m_cellsForItem.erase(it);
 
     disconnect(item, &ItemContainer::sizeHintsChanged, this, nullptr);
 }
@@ -326,12 +315,28 @@ QRect GridLayoutManager::cellBasedBoundingGeometry(const QRectF &geom) const
 
 bool GridLayoutManager::isOutOfBounds(const QPair<int, int> &cell) const
 {
-    return cell.first < 0 || cell.second < 0 || cell.first >= rows() || cell.second >= columns();
+    return cell.first < 0 || cell.second < 0 || cell.first >= m_grid.rows() || cell.second >= m_grid.columns();
 }
 
 bool GridLayoutManager::isCellAvailable(const QPair<int, int> &cell) const
 {
-    return !isOutOfBounds(cell) && !m_grid.contains(cell);
+    return !m_grid.isTaken(cell.first, cell.second);
+}
+
+void GridLayoutManager::syncGridSize() const
+{
+    const int newRows = rows();
+    const int newColumns = columns();
+
+    if (m_grid.rows() == qMax(0, newRows) && m_grid.columns() == qMax(0, newColumns)) {
+        return;
+    }
+
+    // Cells falling out of the grid are not lost: they get back once it grows again
+    m_grid.resize(newRows, newColumns);
+    for (const QRect &cells : m_cellsForItem) {
+        m_grid.setTaken(cells, true);
+    }
 }
 
 QRectF GridLayoutManager::itemGeometry(QQuickItem *item) const
@@ -339,96 +344,57 @@ QRectF GridLayoutManager::itemGeometry(QQuickItem *item) const
     return QRectF(item->x(), item->y(), item->width(), item->height());
 }
 
-QPair<int, int> GridLayoutManager::nextCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const
+QPair<int, int> GridLayoutManager::nextAvailableCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const
 {
-    QPair<int, int> nCell = cell;
+    return nextCellInState(cell, direction, false);
+}
 
+QPair<int, int> GridLayoutManager::nextTakenCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const
+{
+    return nextCellInState(cell, direction, true);
+}
+
+QPair<int, int> GridLayoutManager::nextCellInState(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction, bool taken) const
+{
+    if (isOutOfBounds(cell)) {
+        return QPair<int, int>(-1, -1);
+    }
+
+    // Walk the lines (rows or columns) in the direction, wrapping to the start of the next line at the end of each one
     switch (direction) {
     case AppletsLayout::AppletsLayout::BottomToTop:
-        --nCell.first;
+        for (int column = cell.second, row = cell.first - 1; column >= 0; --column, row = m_grid.rows() - 1) {
+            row = m_grid.nextInColumn(row, column, -1, taken);
+            if (row >= 0) {
+                return QPair<int, int>(row, column);
+            }
+        }
         break;
     case AppletsLayout::AppletsLayout::TopToBottom:
-        ++nCell.first;
+        for (int column = cell.second, row = cell.first + 1; column < m_grid.columns(); ++column, row = 0) {
+            row = m_grid.nextInColumn(row, column, 1, taken);
+            if (row >= 0) {
+                return QPair<int, int>(row, column);
+            }
+        }
         break;
     case AppletsLayout::AppletsLayout::RightToLeft:
-        --nCell.second;
+        for (int row = cell.first, column = cell.second - 1; row >= 0; --row, column = m_grid.columns() - 1) {
+            column = m_grid.nextInRow(row, column, -1, taken);
+            if (column >= 0) {
+                return QPair<int, int>(row, column);
+            }
+        }
         break;
     case AppletsLayout::AppletsLayout::LeftToRight:
     default:
-        ++nCell.second;
-        break;
-    }
-
-    return nCell;
-}
-
-QPair<int, int> GridLayoutManager::nextAvailableCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const
-{
-    QPair<int, int> nCell = cell;
-    while (!isOutOfBounds(nCell)) {
-        nCell = nextCell(nCell, direction);
-
-        if (isOutOfBounds(nCell)) {
-            switch (direction) {
-            case AppletsLayout::AppletsLayout::BottomToTop:
-                nCell.first = rows() - 1;
-                --nCell.second;
-                break;
-            case AppletsLayout::AppletsLayout::TopToBottom:
-                nCell.first = 0;
-                ++nCell.second;
-                break;
-            case AppletsLayout::AppletsLayout::RightToLeft:
-                --nCell.first;
-                nCell.second = columns() - 1;
-                break;
-            case AppletsLayout::AppletsLayout::LeftToRight:
-            default:
-                ++nCell.first;
-                nCell.second = 0;
-                break;
+        for (int row = cell.first, column = cell.second + 1; row < m_grid.rows(); ++row, column = 0) {
+            column = m_grid.nextInRow(row, column, 1, taken);
+            if (column >= 0) {
+                return QPair<int, int>(row, column);
             }
         }
-
-        if (isCellAvailable(nCell)) {
-            return nCell;
-        }
-    }
-
-    return QPair<int, int>(-1, -1);
-}
-
-QPair<int, int> GridLayoutManager::nextTakenCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const
-{
-    QPair<int, int> nCell = cell;
-    while (!isOutOfBounds(nCell)) {
-        nCell = nextCell(nCell, direction);
-
-        if (isOutOfBounds(nCell)) {
-            switch (direction) {
-            case AppletsLayout::AppletsLayout::BottomToTop:
-                nCell.first = rows() - 1;
-                --nCell.second;
-                break;
-            case AppletsLayout::AppletsLayout::TopToBottom:
-                nCell.first = 0;
-                ++nCell.second;
-                break;
-            case AppletsLayout::AppletsLayout::RightToLeft:
-                --nCell.first;
-                nCell.second = columns() - 1;
-                break;
-            case AppletsLayout::AppletsLayout::LeftToRight:
-            default:
-                ++nCell.first;
-                nCell.second = 0;
-                break;
-            }
-        }
-
-        if (!isCellAvailable(nCell)) {
-            return nCell;
-        }
+        break;
     }
 
     return QPair<int, int>(-1, -1);
@@ -436,20 +402,33 @@ QPair<int, int> GridLayoutManager::nextTakenCell(const QPair<int, int> &cell, Ap
 
 int GridLayoutManager::freeSpaceInDirection(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const
 {
-    QPair<int, int> nCell = cell;
+    if (!isCellAvailable(cell)) {
+        return 0;
+    }
 
-    int avail = 0;
+    int taken;
 
-    while (isCellAvailable(nCell)) {
-        ++avail;
-        nCell = nextCell(nCell, direction);
+    switch (direction) {
+    case AppletsLayout::AppletsLayout::BottomToTop:
+        taken = m_grid.nextInColumn(cell.first, cell.second, -1, true);
+        return cell.first - taken;
+    case AppletsLayout::AppletsLayout::TopToBottom:
+        taken = m_grid.nextInColumn(cell.first, cell.second, 1, true);
+        return (taken < 0 ? m_grid.rows() : taken) - cell.first;
+    case AppletsLayout::AppletsLayout::RightToLeft:
+        taken = m_grid.nextInRow(cell.first, cell.second, -1, true);
+        return cell.second - taken;
+    case AppletsLayout::AppletsLayout::LeftToRight:
+    default:
+        taken = m_grid.nextInRow(cell.first, cell.second, 1, true);
+        return (taken < 0 ? m_grid.columns() : taken) - cell.second;
     }
-
-    return avail;
 }
 
 QRectF GridLayoutManager::nextAvailableSpace(ItemContainer *item, const QSizeF &minimumSize, AppletsLayout::PreferredLayoutDirection direction) const
 {
+    syncGridSize();
+
     // The mionimum size in grid units
     const QSize minimumGridSize(ceil((qreal)minimumSize.width() / cellSize().width()), ceil((qreal)minimumSize.height() / cellSize().height()));
 
@@ -471,25 +450,38 @@ QRectF GridLayoutManager::nextAvailableSpace(ItemContainer *item, const QSizeF &
     }
 
     while (!isOutOfBounds(cell)) {
+        // Usually the whole item fits right at the cell, which the occupancy grid tells in one lookup
+        QRect candidate(QPoint(cell.second, cell.first), itemCellGeom.size());
+        if (direction == AppletsLayout::AppletsLayout::RightToLeft) {
+            candidate.moveRight(cell.second);
+        } else if (direction == AppletsLayout::AppletsLayout::BottomToTop) {
+            candidate.moveBottom(cell.first);
+        }
+        const bool fitsWhole = m_grid.isFree(candidate);
+
         if (direction == AppletsLayout::LeftToRight || direction == AppletsLayout::RightToLeft) {
             partialSize = QSize(INT_MAX, 0);
 
-            int currentRow = cell.first;
-            for (; currentRow < cell.first + itemCellGeom.height(); ++currentRow) {
-                const int freeRow = freeSpaceInDirection(QPair<int, int>(currentRow, cell.second), direction);
-
-                partialSize.setWidth(qMin(partialSize.width(), freeRow));
-
-                if (freeRow > 0) {
-                    partialSize.setHeight(partialSize.height() + 1);
-                } else if (partialSize.height() < minimumGridSize.height()) {
-                    break;
-                }
-
-                if (partialSize.width() >= itemCellGeom.width() && partialSize.height() >= itemCellGeom.height()) {
-                    break;
-                } else if (partialSize.width() < minimumGridSize.width()) {
-                    break;
+            if (fitsWhole) {
+                partialSize = itemCellGeom.size();
+            } else {
+                int currentRow = cell.first;
+                for (; currentRow < cell.first + itemCellGeom.height(); ++currentRow) {
+                    const int freeRow = freeSpaceInDirection(QPair<int, int>(currentRow, cell.second), direction);
+
+                    partialSize.setWidth(qMin(partialSize.width(), freeRow));
+
+                    if (freeRow > 0) {
+                        partialSize.setHeight(partialSize.height() + 1);
+                    } else if (partialSize.height() < minimumGridSize.height()) {
+                        break;
+                    }
+
+                    if (partialSize.width() >= itemCellGeom.width() && partialSize.height() >= itemCellGeom.height()) {
+                        break;
+                    } else if (partialSize.width() < minimumGridSize.width()) {
+                        break;
+                    }
                 }
             }
 
@@ -510,22 +502,26 @@ QRectF GridLayoutManager::nextAvailableSpace(ItemContainer *item, const QSizeF &
         } else if (direction == AppletsLayout::TopToBottom || direction == AppletsLayout::BottomToTop) {
             partialSize = QSize(0, INT_MAX);
 
-            int currentColumn = cell.second;
-            for (; currentColumn < cell.second + itemCellGeom.width(); ++currentColumn) {
-                const int freeColumn = freeSpaceInDirection(QPair<int, int>(cell.first, currentColumn), direction);
-
-                partialSize.setHeight(qMin(partialSize.height(), freeColumn));
-
-                if (freeColumn > 0) {
-                    partialSize.setWidth(partialSize.width() + 1);
-                } else if (partialSize.width() < minimumGridSize.width()) {
-                    break;
-                }
-
-                if (partialSize.width() >= itemCellGeom.width() && partialSize.height() >= itemCellGeom.height()) {
-                    break;
-                } else if (partialSize.height() < minimumGridSize.height()) {
-                    break;
+            if (fitsWhole) {
+                partialSize = itemCellGeom.size();
+            } else {
+                int currentColumn = cell.second;
+                for (; currentColumn < cell.second + itemCellGeom.width(); ++currentColumn) {
+                    const int freeColumn = freeSpaceInDirection(QPair<int, int>(cell.first, currentColumn), direction);
+
+                    partialSize.setHeight(qMin(partialSize.height(), freeColumn));
+
+                    if (freeColumn > 0) {
+                        partialSize.setWidth(partialSize.width() + 1);
+                    } else if (partialSize.width() < minimumGridSize.width()) {
+                        break;
+                    }
+
+                    if (partialSize.width() >= itemCellGeom.width() && partialSize.height() >= itemCellGeom.height()) {
+                        break;
+                    } else if (partialSize.height() < minimumGridSize.height()) {
+                        break;
+                    }
                 }
             }
 
@@ -8,6 +8,7 @@
 
 #include "abstractlayoutmanager.h"
 #include "appletcontainer.h"
+#include "gridoccupancy.h"
 
 class AppletsLayout;
 class ItemContainer;
@@ -72,15 +73,18 @@ private:
     // Returns the qrect geometry for an item
     inline QRectF itemGeometry(QQuickItem *item) const;
 
-    // The next cell given the direction
-    QPair<int, int> nextCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const;
-
     // The next cell that is available given the direction
     QPair<int, int> nextAvailableCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const;
 
     // The next cell that is has something in it given the direction
     QPair<int, int> nextTakenCell(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const;
 
+    // The next cell after the given one, wrapping at the end of lines, which is taken or not
+    QPair<int, int> nextCellInState(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction, bool taken) const;
+
+    // Resizes the occupancy grid if the layout or cell size changed since it was last used
+    void syncGridSize() const;
+
     // How many cells are available in the row starting from the given cell and direction
     int freeSpaceInDirection(const QPair<int, int> &cell, AppletsLayout::PreferredLayoutDirection direction) const;
 
@@ -89,10 +93,10 @@ private:
      */
     void adjustToItemSizeHints(ItemContainer *item);
 
-    // What is the item that occupies the point. The point is expressed in cells rather than pixels. a qpair rather a QPointF as QHash doesn't support
-    // identification by QPointF
-    QHash<QPair<int, int>, ItemContainer *> m_grid;
-    QHash<ItemContainer *, QSet<QPair<int, int>>> m_pointsForItem;
+    // Which cells are taken. Mutable as the layout size may change under const queries
+    mutable GridOccupancy m_grid;
+    // The cells taken by each item, in cells rather than pixels
+    QHash<ItemContainer *, QRect> m_cellsForItem;
 
     QHash<QString, Geom> m_parsedConfig;
 };
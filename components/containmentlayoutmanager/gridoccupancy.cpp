@@ -0,0 +1,191 @@
+/*
+    SPDX-FileCopyrightText: 2019 Marco Martin <mart@kde.org>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "gridoccupancy.h"
+
+#include <QtAlgorithms>
+
+namespace
+{
+constexpr int s_bitsPerWord = 64;
+// Rebuilding the summed-area table costs a pass over the whole grid, which is only worth
+// it when several queries come in without the grid changing in between
+constexpr int s_scansBeforeIndexing = 2;
+
+// The bits from first to last, both included, of a word
+inline quint64 bitRange(int first, int last)
+{
+    const quint64 upTo = last == s_bitsPerWord - 1 ? ~quint64(0) : (quint64(1) << (last + 1)) - 1;
+    return upTo & (~quint64(0) << first);
+}
+}
+
+void GridOccupancy::resize(int rows, int columns)
+{
+    m_rows = qMax(0, rows);
+    m_columns = qMax(0, columns);
+    m_wordsPerRow = (m_columns + s_bitsPerWord - 1) / s_bitsPerWord;
+    m_bits.fill(0, m_rows * m_wordsPerRow);
+    m_summedArea.clear();
+    m_summedAreaValid = false;
+    m_scansSinceChange = 0;
+}
+
+void GridOccupancy::clear()
+{
+    m_bits.fill(0);
+    m_summedAreaValid = false;
+    m_scansSinceChange = 0;
+}
+
+void GridOccupancy::setTaken(const QRect &cells, bool taken)
+{
+    const QRect clipped = cells & QRect(0, 0, m_columns, m_rows);
+    if (clipped.isEmpty()) {
+        return;
+    }
+
+    const int firstWord = clipped.left() / s_bitsPerWord;
+    const int lastWord = clipped.right() / s_bitsPerWord;
+
+    for (int row = clipped.top(); row <= clipped.bottom(); ++row) {
+        quint64 *rowBits = m_bits.data() + row * m_wordsPerRow;
+        for (int index = firstWord; index <= lastWord; ++index) {
+            const int first = index == firstWord ? clipped.left() % s_bitsPerWord : 0;
+            const int last = index == lastWord ? clipped.right() % s_bitsPerWord : s_bitsPerWord - 1;
+            if (taken) {
+                rowBits[index] |= bitRange(first, last);
+            } else {
+                rowBits[index] &= ~bitRange(first, last);
+            }
+        }
+    }
+
+    m_summedAreaValid = false;
+    m_scansSinceChange = 0;
+}
+
+bool GridOccupancy::isTaken(int row, int column) const
+{
+    if (row < 0 || column < 0 || row >= m_rows || column >= m_columns) {
+        return true;
+    }
+    return word(row, column / s_bitsPerWord) & (quint64(1) << (column % s_bitsPerWord));
+}
+
+bool GridOccupancy::isFree(const QRect &cells) const
+{
+    if (cells.isEmpty()) {
+        return true;
+    }
+    if (!QRect(0, 0, m_columns, m_rows).contains(cells)) {
+        return false;
+    }
+
+    if (!m_summedAreaValid) {
+        if (++m_scansSinceChange <= s_scansBeforeIndexing) {
+            return scanIsFree(cells);
+        }
+        updateSummedArea();
+    }
+
+    return takenCount(cells) == 0;
+}
+
+int GridOccupancy::takenCount(const QRect &cells) const
+{
+    Q_ASSERT(QRect(0, 0, m_columns, m_rows).contains(cells));
+    updateSummedArea();
+
+    return summedArea(cells.bottom() + 1, cells.right() + 1) - summedArea(cells.top(), cells.right() + 1) - summedArea(cells.bottom() + 1, cells.left())
+        + summedArea(cells.top(), cells.left());
+}
+
+int GridOccupancy::nextInRow(int row, int column, int step, bool taken) const
+{
+    if (row < 0 || row >= m_rows) {
+        return -1;
+    }
+
+    if (step > 0) {
+        for (int current = qMax(0, column); current < m_columns;) {
+            const int index = current / s_bitsPerWord;
+            const quint64 bits = (taken ? word(row, index) : ~word(row, index)) & bitRange(current % s_bitsPerWord, s_bitsPerWord - 1);
+            if (bits) {
+                // The padding bits past the last column read as free
+                const int found = index * s_bitsPerWord + qCountTrailingZeroBits(bits);
+                return found < m_columns ? found : -1;
+            }
+            current = (index + 1) * s_bitsPerWord;
+        }
+    } else {
+        for (int current = qMin(column, m_columns - 1); current >= 0;) {
+            const int index = current / s_bitsPerWord;
+            const quint64 bits = (taken ? word(row, index) : ~word(row, index)) & bitRange(0, current % s_bitsPerWord);
+            if (bits) {
+                return index * s_bitsPerWord + s_bitsPerWord - 1 - qCountLeadingZeroBits(bits);
+            }
+            current = index * s_bitsPerWord - 1;
+        }
+    }
+
+    return -1;
+}
+
+int GridOccupancy::nextInColumn(int row, int column, int step, bool taken) const
+{
+    if (column < 0 || column >= m_columns) {
+        return -1;
+    }
+
+    for (int current = row; current >= 0 && current < m_rows; current += step) {
+        if (isTaken(current, column) == taken) {
+            return current;
+        }
+    }
+
+    return -1;
+}
+
+bool GridOccupancy::scanIsFree(const QRect &cells) const
+{
+    const int firstWord = cells.left() / s_bitsPerWord;
+    const int lastWord = cells.right() / s_bitsPerWord;
+
+    for (int row = cells.top(); row <= cells.bottom(); ++row) {
+        for (int index = firstWord; index <= lastWord; ++index) {
+            const int first = index == firstWord ? cells.left() % s_bitsPerWord : 0;
+            const int last = index == lastWord ? cells.right() % s_bitsPerWord : s_bitsPerWord - 1;
+            if (word(row, index) & bitRange(first, last)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void GridOccupancy::updateSummedArea() const
+{
+    if (m_summedAreaValid) {
+        return;
+    }
+
+    const int stride = m_columns + 1;
+    m_summedArea.fill(0, (m_rows + 1) * stride);
+
+    int *sums = m_summedArea.data();
+    for (int row = 0; row < m_rows; ++row) {
+        int rowSum = 0;
+        for (int column = 0; column < m_columns; ++column) {
+            rowSum += (word(row, column / s_bitsPerWord) >> (column % s_bitsPerWord)) & 1;
+            sums[(row + 1) * stride + column + 1] = sums[row * stride + column + 1] + rowSum;
+        }
+    }
+
+    m_summedAreaValid = true;
+}
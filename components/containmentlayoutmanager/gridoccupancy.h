@@ -0,0 +1,88 @@
+/*
+    SPDX-FileCopyrightText: 2019 Marco Martin <mart@kde.org>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QRect>
+#include <QVector>
+
+/**
+ * Occupancy of the cells of a layout grid.
+ *
+ * Cells are stored one bit each, row by row, so scanning a row for the next free or taken
+ * cell looks at 64 cells at a time. On top of the bits a summed-area table is kept, which
+ * tells whether an arbitrary rectangle of cells is free with four lookups. The table is
+ * rebuilt lazily: while cells keep being taken and released, rectangles are checked on the
+ * bits directly, and the table is only rebuilt once queries start to outnumber changes.
+ *
+ * Rectangles are expressed in cells, x being the column and y the row.
+ */
+class GridOccupancy
+{
+public:
+    GridOccupancy() = default;
+
+    // Resizes the grid, all cells become free
+    void resize(int rows, int columns);
+
+    int rows() const
+    {
+        return m_rows;
+    }
+
+    int columns() const
+    {
+        return m_columns;
+    }
+
+    // Marks all cells as free
+    void clear();
+
+    // Marks the cells of the rectangle as taken or free, the parts outside the grid are ignored
+    void setTaken(const QRect &cells, bool taken);
+
+    // Cells out of the grid are reported as taken
+    bool isTaken(int row, int column) const;
+
+    // True if the rectangle is entirely inside the grid and none of its cells is taken
+    bool isFree(const QRect &cells) const;
+
+    // The number of taken cells in the rectangle, which must be inside the grid
+    int takenCount(const QRect &cells) const;
+
+    // The first column in the row starting from column, going in direction step (1 or -1)
+    // which is taken (or free if taken is false), -1 if there is none
+    int nextInRow(int row, int column, int step, bool taken) const;
+
+    // Same as nextInRow, walking a column
+    int nextInColumn(int row, int column, int step, bool taken) const;
+
+private:
+    inline quint64 word(int row, int index) const
+    {
+        return m_bits[row * m_wordsPerRow + index];
+    }
+
+    inline int summedArea(int row, int column) const
+    {
+        return m_summedArea[row * (m_columns + 1) + column];
+    }
+
+    bool scanIsFree(const QRect &cells) const;
+    void updateSummedArea() const;
+
+    int m_rows = 0;
+    int m_columns = 0;
+    int m_wordsPerRow = 0;
+    QVector<quint64> m_bits;
+
+    // (rows + 1) * (columns + 1) prefix sums of taken cells
+    mutable QVector<int> m_summedArea;
+    mutable bool m_summedAreaValid = false;
+    // Queries answered by scanning since the last change
+    mutable int m_scansSinceChange = 0;
+};
@@ -17,7 +17,8 @@
 #include <KJsonUtils>
 #include <KLocalizedString>
 #include <KPackage/PackageLoader>
-#include <KSycoca>
+
+#include <appletmetadatacatalog.h>
 
 PlasmaAppletItem::PlasmaAppletItem(const KPluginMetaData &info)
     : AbstractItem()
@@ -234,7 +235,7 @@ PlasmaAppletItemModel::PlasmaAppletItemModel(QObject *parent)
     : QStandardItemModel(parent)
     , m_startupCompleted(false)
 {
-    connect(KSycoca::self(), &KSycoca::databaseChanged, this, &PlasmaAppletItemModel::populateModel);
+    connect(AppletMetaDataCatalog::self(), &AppletMetaDataCatalog::changed, this, &PlasmaAppletItemModel::populateModel);
 
     setSortRole(Qt::DisplayRole);
 }
@@ -297,11 +298,27 @@ void PlasmaAppletItemModel::populateModel()
         return true;
     };
 
-    const QList<KPluginMetaData> packages =
-        KPackage::PackageLoader::self()->findPackages(QStringLiteral("Plasma/Applet"), QStringLiteral("plasma/plasmoids"), filter);
+    QList<KPluginMetaData> packages;
+    if (m_provides.isEmpty()) {
+        packages = AppletMetaDataCatalog::self()->applets();
+    } else {
+        // an applet can fulfill several of the requested provides, only list it once
+        QSet<QString> seen;
+        for (const QString &provides : qAsConst(m_provides)) {
+            const QList<KPluginMetaData> providers = AppletMetaDataCatalog::self()->appletsProviding(provides);
+            for (const KPluginMetaData &plugin : providers) {
+                if (!seen.contains(plugin.pluginId())) {
+                    seen.insert(plugin.pluginId());
+                    packages << plugin;
+                }
+            }
+        }
+    }
 
-    for (const KPluginMetaData &plugin : packages) {
-        appendRow(new PlasmaAppletItem(plugin));
+    for (const KPluginMetaData &plugin : qAsConst(packages)) {
+        if (filter(plugin)) {
+            appendRow(new PlasmaAppletItem(plugin));
+        }
     }
 
     Q_EMIT modelPopulated();
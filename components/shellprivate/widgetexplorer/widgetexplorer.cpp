@@ -21,7 +21,6 @@
 #include <Plasma/Applet>
 #include <Plasma/Containment>
 #include <Plasma/Corona>
-#include <Plasma/PluginLoader>
 #include <QStandardPaths>
 
 #include <KActivities/Consumer>
@@ -30,6 +29,8 @@
 #include <KPackage/PackageLoader>
 #include <KPackage/PackageStructure>
 
+#include <appletmetadatacatalog.h>
+
 #include "config-workspace.h"
 #include "kcategorizeditemsviewmodels_p.h"
 #include "openwidgetassistant_p.h"
@@ -126,7 +127,7 @@ void WidgetExplorerPrivate::initFilters()
     QMap<QString, catPair> categories;
     QSet<QString> existingCategories = itemModel.categories();
     QStringList cats;
-    const QList<KPluginMetaData> list = PluginLoader::self()->listAppletMetaData(QString());
+    const QList<KPluginMetaData> list = AppletMetaDataCatalog::self()->applets();
 
     for (auto &plugin : list) {
         if (!plugin.isValid()) {
@@ -0,0 +1,201 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <QDBusConnection>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "../multiplexer.h"
+#include "../playercontainer.h"
+
+// Players that do not exist on the bus, only their PlaybackStatus is set by hand
+class MultiplexerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testFirstPlayer();
+    void testHigherStatusWins();
+    void testEqualStatusKeepsActive();
+    void testActiveLosesStatus();
+    void testOtherDataKeepsActive();
+    void testRemoveActive();
+    void testRemoveAll();
+
+private:
+    PlayerContainer *addPlayer(const QString &name, const QString &status);
+    void setStatus(PlayerContainer *player, const QString &status);
+    QString activeName() const;
+
+    Multiplexer *m_multiplexer = nullptr;
+};
+
+void MultiplexerTest::initTestCase()
+{
+    // PlayerContainer asks the bus for the pid of the player
+    if (!QDBusConnection::sessionBus().isConnected()) {
+        QSKIP("No session bus");
+    }
+}
+
+void MultiplexerTest::init()
+{
+    m_multiplexer = new Multiplexer(this);
+}
+
+void MultiplexerTest::cleanup()
+{
+    delete m_multiplexer;
+    m_multiplexer = nullptr;
+    qDeleteAll(findChildren<PlayerContainer *>());
+}
+
+PlayerContainer *MultiplexerTest::addPlayer(const QString &name, const QString &status)
+{
+    auto player = new PlayerContainer(QStringLiteral("org.mpris.MediaPlayer2.") + name, this);
+    player->setObjectName(name);
+    player->setData(QStringLiteral("PlaybackStatus"), status);
+    m_multiplexer->addPlayer(player);
+    return player;
+}
+
+void MultiplexerTest::setStatus(PlayerContainer *player, const QString &status)
+{
+    player->setData(QStringLiteral("PlaybackStatus"), status);
+    player->forceImmediateUpdate();
+}
+
+QString MultiplexerTest::activeName() const
+{
+    PlayerContainer *active = m_multiplexer->activePlayer();
+    const QString name = active ? active->objectName() : QString();
+    // What the multiplexer forwards has to be in line with it
+    if (m_multiplexer->data().value(QStringLiteral("Source Name")).toString() != name) {
+        return QStringLiteral("<forwarded data out of sync>");
+    }
+    return name;
+}
+
+void MultiplexerTest::testFirstPlayer()
+{
+    QSignalSpy spy(m_multiplexer, &Multiplexer::activePlayerChanged);
+
+    PlayerContainer *a = addPlayer(QStringLiteral("a"), QStringLiteral("Stopped"));
+
+    QCOMPARE(m_multiplexer->activePlayer(), a);
+    QCOMPARE(activeName(), QStringLiteral("a"));
+    QCOMPARE(m_multiplexer->data().value(QStringLiteral("PlaybackStatus")).toString(), QStringLiteral("Stopped"));
+    QCOMPARE(spy.count(), 1);
+}
+
+void MultiplexerTest::testHigherStatusWins()
+{
+    addPlayer(QStringLiteral("a"), QStringLiteral("Stopped"));
+
+    PlayerContainer *b = addPlayer(QStringLiteral("b"), QStringLiteral("Paused"));
+    QCOMPARE(activeName(), QStringLiteral("b"));
+
+    PlayerContainer *c = addPlayer(QStringLiteral("c"), QStringLiteral("Stopped"));
+    QCOMPARE(activeName(), QStringLiteral("b"));
+
+    setStatus(c, QStringLiteral("Playing"));
+    QCOMPARE(activeName(), QStringLiteral("c"));
+    QCOMPARE(m_multiplexer->data().value(QStringLiteral("PlaybackStatus")).toString(), QStringLiteral("Playing"));
+
+    // Paused is no better than playing
+    setStatus(b, QStringLiteral("Stopped"));
+    setStatus(b, QStringLiteral("Paused"));
+    QCOMPARE(activeName(), QStringLiteral("c"));
+}
+
+void MultiplexerTest::testEqualStatusKeepsActive()
+{
+    addPlayer(QStringLiteral("a"), QStringLiteral("Playing"));
+    PlayerContainer *b = addPlayer(QStringLiteral("b"), QStringLiteral("Paused"));
+
+    setStatus(b, QStringLiteral("Playing"));
+    QCOMPARE(activeName(), QStringLiteral("a"));
+}
+
+void MultiplexerTest::testActiveLosesStatus()
+{
+    PlayerContainer *a = addPlayer(QStringLiteral("a"), QStringLiteral("Playing"));
+    PlayerContainer *b = addPlayer(QStringLiteral("b"), QStringLiteral("Paused"));
+    PlayerContainer *c = addPlayer(QStringLiteral("c"), QStringLiteral("Paused"));
+    QCOMPARE(activeName(), QStringLiteral("a"));
+
+    // Among paused players the one paused last wins
+    setStatus(b, QStringLiteral("Playing"));
+    setStatus(b, QStringLiteral("Paused"));
+    setStatus(a, QStringLiteral("Stopped"));
+    QCOMPARE(activeName(), QStringLiteral("b"));
+
+    setStatus(c, QStringLiteral("Playing"));
+    QCOMPARE(activeName(), QStringLiteral("c"));
+
+    // Still the best one, so it stays
+    setStatus(c, QStringLiteral("Paused"));
+    QCOMPARE(activeName(), QStringLiteral("c"));
+    QCOMPARE(m_multiplexer->data().value(QStringLiteral("PlaybackStatus")).toString(), QStringLiteral("Paused"));
+}
+
+void MultiplexerTest::testOtherDataKeepsActive()
+{
+    addPlayer(QStringLiteral("a"), QStringLiteral("Paused"));
+    PlayerContainer *b = addPlayer(QStringLiteral("b"), QStringLiteral("Paused"));
+    QSignalSpy spy(m_multiplexer, &Multiplexer::activePlayerChanged);
+
+    b->setData(QStringLiteral("Metadata"), QVariantMap{{QStringLiteral("xesam:title"), QStringLiteral("B")}});
+    b->forceImmediateUpdate();
+
+    QCOMPARE(activeName(), QStringLiteral("a"));
+    QVERIFY(!m_multiplexer->data().contains(QStringLiteral("Metadata")));
+    QCOMPARE(spy.count(), 0);
+}
+
+void MultiplexerTest::testRemoveActive()
+{
+    addPlayer(QStringLiteral("a"), QStringLiteral("Stopped"));
+    addPlayer(QStringLiteral("b"), QStringLiteral("Paused"));
+    addPlayer(QStringLiteral("c"), QStringLiteral("Playing"));
+    addPlayer(QStringLiteral("d"), QStringLiteral("Paused"));
+    QCOMPARE(activeName(), QStringLiteral("c"));
+
+    m_multiplexer->removePlayer(QStringLiteral("c"));
+    QCOMPARE(activeName(), QStringLiteral("d"));
+
+    m_multiplexer->removePlayer(QStringLiteral("d"));
+    QCOMPARE(activeName(), QStringLiteral("b"));
+
+    // Removing another player leaves the active one alone
+    m_multiplexer->removePlayer(QStringLiteral("a"));
+    QCOMPARE(activeName(), QStringLiteral("b"));
+}
+
+void MultiplexerTest::testRemoveAll()
+{
+    addPlayer(QStringLiteral("a"), QStringLiteral("Playing"));
+    addPlayer(QStringLiteral("b"), QStringLiteral("Paused"));
+    QSignalSpy emptied(m_multiplexer, &Multiplexer::playerListEmptied);
+
+    m_multiplexer->removePlayer(QStringLiteral("a"));
+    QCOMPARE(activeName(), QStringLiteral("b"));
+    QCOMPARE(emptied.count(), 0);
+
+    m_multiplexer->removePlayer(QStringLiteral("b"));
+    QCOMPARE(m_multiplexer->activePlayer(), nullptr);
+    QVERIFY(m_multiplexer->data().isEmpty());
+    QCOMPARE(emptied.count(), 1);
+}
+
+QTEST_GUILESS_MAIN(MultiplexerTest)
+
+#include "multiplexertest.moc"
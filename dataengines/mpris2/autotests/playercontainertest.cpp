@@ -0,0 +1,83 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <QDBusObjectPath>
+#include <QObject>
+#include <QTest>
+#include <QUrl>
+
+#include "../playercontainer.h"
+
+class PlayerContainerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testIsNewTrack_data();
+    void testIsNewTrack();
+};
+
+namespace
+{
+QVariantMap track(const QString &trackId, qlonglong length, const QString &url, const QString &title)
+{
+    return {
+        {QStringLiteral("mpris:trackid"), QVariant::fromValue(QDBusObjectPath(trackId))},
+        {QStringLiteral("mpris:length"), length},
+        {QStringLiteral("xesam:url"), QUrl(url)},
+        {QStringLiteral("xesam:title"), title},
+    };
+}
+}
+
+void PlayerContainerTest::testIsNewTrack_data()
+{
+    QTest::addColumn<QVariantMap>("oldMetadata");
+    QTest::addColumn<QVariantMap>("newMetadata");
+    QTest::addColumn<bool>("isNewTrack");
+
+    const QVariantMap first = track(QStringLiteral("/org/mpris/MediaPlayer2/Track/1"), 180000000, QStringLiteral("file:///music/a.ogg"), QStringLiteral("A"));
+
+    QTest::newRow("same track") << first << first << false;
+
+    QVariantMap artChanged = first;
+    artChanged.insert(QStringLiteral("mpris:artUrl"), QUrl(QStringLiteral("file:///music/a.png")));
+    QTest::newRow("art of the same track") << first << artChanged << false;
+
+    QTest::newRow("other track id") << first
+                                    << track(QStringLiteral("/org/mpris/MediaPlayer2/Track/2"), 180000000, QStringLiteral("file:///music/a.ogg"), QStringLiteral("A"))
+                                    << true;
+
+    // players reusing a single track id, or not setting one at all
+    QTest::newRow("same track id, other length")
+        << first << track(QStringLiteral("/org/mpris/MediaPlayer2/Track/1"), 240000000, QStringLiteral("file:///music/a.ogg"), QStringLiteral("A")) << true;
+    QTest::newRow("same track id, other url")
+        << first << track(QStringLiteral("/org/mpris/MediaPlayer2/Track/1"), 180000000, QStringLiteral("file:///music/b.ogg"), QStringLiteral("A")) << true;
+    QTest::newRow("same track id, other title")
+        << first << track(QStringLiteral("/org/mpris/MediaPlayer2/Track/1"), 180000000, QStringLiteral("file:///music/a.ogg"), QStringLiteral("B")) << true;
+
+    // the stored metadata has no length when the player sent a bogus one
+    QVariantMap withoutLength = first;
+    withoutLength.remove(QStringLiteral("mpris:length"));
+    QVariantMap zeroLength = first;
+    zeroLength.insert(QStringLiteral("mpris:length"), 0LL);
+    QTest::newRow("no length, zero length") << withoutLength << zeroLength << false;
+
+    QTest::newRow("no metadata yet") << QVariantMap() << first << true;
+}
+
+void PlayerContainerTest::testIsNewTrack()
+{
+    QFETCH(QVariantMap, oldMetadata);
+    QFETCH(QVariantMap, newMetadata);
+    QFETCH(bool, isNewTrack);
+
+    QCOMPARE(PlayerContainer::isNewTrack(oldMetadata, newMetadata), isNewTrack);
+}
+
+QTEST_GUILESS_MAIN(PlayerContainerTest)
+
+#include "playercontainertest.moc"
@@ -12,8 +12,6 @@
 #include <QAction>
 #include <QDebug> // for Q_ASSERT
 
-#include <algorithm>
-
 #include "debug.h"
 
 // the '@' at the start is not valid for D-Bus names, so it will
@@ -26,109 +24,136 @@ Multiplexer::Multiplexer(QObject *parent)
     setObjectName(sourceName);
 }
 
-void Multiplexer::evaluatePlayer(PlayerContainer *container)
+bool Multiplexer::updatePlayerInfo(PlayerInfo &info)
 {
-    bool makeActive = m_activeName.isEmpty();
+    const Plasma::DataEngine::Data data = info.container->data();
+    const QString name = info.container->objectName();
 
-    QString name = container->objectName();
-    const QString containerPlaybackStatus = container->data().value(QStringLiteral("PlaybackStatus")).toString();
-    const QString multiplexerPlaybackStatus = data().value(QStringLiteral("PlaybackStatus")).toString();
+    const QString playbackStatus = data.value(QStringLiteral("PlaybackStatus")).toString();
+    Status status = Stopped;
+    if (playbackStatus == QLatin1String("Playing")) {
+        status = Playing;
+    } else if (playbackStatus == QLatin1String("Paused")) {
+        status = Paused;
+    }
 
-    m_playing.remove(name);
-    m_paused.remove(name);
-    m_stopped.remove(name);
+    info.instancePid = data.value(QStringLiteral("InstancePid")).toUInt();
 
-    // Ensure the actual player is always in the correct category
-    if (containerPlaybackStatus == QLatin1String("Playing")) {
-        m_playing.insert(name, container);
-    } else if (containerPlaybackStatus == QLatin1String("Paused")) {
-        m_paused.insert(name, container);
-    } else {
-        m_stopped.insert(name, container);
-    }
+    const QVariantMap metadata = data.value(QStringLiteral("Metadata")).toMap();
+    if (metadata != info.metadata) {
+        info.metadata = metadata;
 
-    const auto proxyPid = container->data().value(QStringLiteral("Metadata")).toMap().value(QStringLiteral("kde:pid")).toUInt();
-    if (proxyPid) {
-        auto it = m_proxies.find(proxyPid);
-        if (it == m_proxies.end()) {
-            m_proxies.insert(proxyPid, container);
+        const uint proxyPid = metadata.value(QStringLiteral("kde:pid")).toUInt();
+        if (proxyPid != info.proxyPid) {
+            if (info.proxyPid && m_proxies.value(info.proxyPid) == name) {
+                m_proxies.remove(info.proxyPid);
+            }
+            info.proxyPid = proxyPid;
+            // The first proxy for a process stays its proxy
+            if (proxyPid && !m_proxies.contains(proxyPid)) {
+                m_proxies.insert(proxyPid, name);
+            }
         }
     }
 
-    const auto containerPid = container->data().value(QStringLiteral("InstancePid")).toUInt();
-    PlayerContainer *proxy = m_proxies.value(containerPid);
-    if (proxy) {
-        // Operate on the proxy from now on
-        container = proxy;
-        name = container->objectName();
+    if (info.order && status == info.status) {
+        return false;
     }
 
-    if (!makeActive) {
-        // If this player has higher status than the current multiplexer player, switch over to it
-        if (m_playing.value(name) && multiplexerPlaybackStatus != QLatin1String("Playing")) {
-            qCDebug(MPRIS2) << "Player" << name << "is now playing but current was not";
-            makeActive = true;
-        } else if (m_paused.value(name) && multiplexerPlaybackStatus != QLatin1String("Playing") && multiplexerPlaybackStatus != QLatin1String("Paused")) {
-            qCDebug(MPRIS2) << "Player" << name << "is now paused but current was stopped";
-            makeActive = true;
-        }
+    if (info.order) {
+        m_priority.remove({info.status, info.order});
     }
+    info.status = status;
+    info.order = ++m_order;
+    m_priority.insert({info.status, info.order}, name);
 
-    if (m_activeName == name) {
-        // If we are the current player and move to a lower status, switch to another one, if necessary
-        if (m_paused.value(name) && !m_playing.isEmpty()) {
-            qCDebug(MPRIS2) << "Current player" << m_activeName << "is now paused but there is another playing one, switching players";
-            setBestActive();
-            makeActive = false;
-        } else if (m_stopped.value(name) && (!m_playing.isEmpty() || !m_paused.isEmpty())) {
-            qCDebug(MPRIS2) << "Current player" << m_activeName << "is now stopped but there is another playing or paused one, switching players";
+    return true;
+}
+
+QString Multiplexer::proxyFor(const PlayerInfo &info) const
+{
+    const QString proxy = m_proxies.value(info.instancePid);
+    if (proxy.isEmpty() || proxy == info.container->objectName() || !m_players.contains(proxy)) {
+        return QString();
+    }
+    return proxy;
+}
+
+void Multiplexer::evaluatePlayer(const QString &name)
+{
+    auto it = m_players.find(name);
+    if (it == m_players.end()) {
+        return;
+    }
+
+    const bool statusChanged = updatePlayerInfo(*it);
+
+    // Operate on the proxy of a player, if there is one
+    QString effectiveName = proxyFor(*it);
+    if (effectiveName.isEmpty()) {
+        effectiveName = name;
+    }
+    const PlayerInfo &info = m_players[effectiveName];
+
+    if (m_activeName.isEmpty()) {
+        setActive(effectiveName);
+        return;
+    }
+
+    if (m_activeName == effectiveName) {
+        // If we are the current player and moved to a lower status than another one, switch to that
+        if (info.status > m_priority.firstKey().status) {
+            qCDebug(MPRIS2) << "Current player" << m_activeName << "has a lower status than another one, switching players";
             setBestActive();
-            makeActive = false;
         } else {
-            makeActive = true;
+            forwardData(info.container->data());
         }
+        return;
     }
 
-    if (makeActive) {
-        if (m_activeName != name) {
-            qCDebug(MPRIS2) << "Switching from" << m_activeName << "to" << name;
-            m_activeName = name;
-        }
-        replaceData(container->data());
-        checkForUpdate();
-        Q_EMIT activePlayerChanged(container);
+    // Already compared with the current player when it got this status, which
+    // would have been looked at again itself when its own status changed
+    if (!statusChanged && effectiveName == name) {
+        return;
+    }
+
+    // If this player has higher status than the current multiplexer player, switch over to it
+    if (info.status < m_players.value(m_activeName).status) {
+        qCDebug(MPRIS2) << "Player" << effectiveName << "has a higher status than the current one";
+        setActive(effectiveName);
     }
 }
 
 void Multiplexer::addPlayer(PlayerContainer *container)
 {
-    evaluatePlayer(container);
+    const QString name = container->objectName();
+    m_players[name].container = container;
+
+    evaluatePlayer(name);
 
     connect(container, &Plasma::DataContainer::dataUpdated, this, &Multiplexer::playerUpdated);
 }
 
 void Multiplexer::removePlayer(const QString &name)
 {
-    PlayerContainer *container = m_playing.take(name);
-    if (!container)
-        container = m_paused.take(name);
-    if (!container)
-        container = m_stopped.take(name);
-    if (container)
-        container->disconnect(this);
+    auto it = m_players.find(name);
+    if (it != m_players.end()) {
+        it->container->disconnect(this);
 
-    // Remove proxy by value (container), not key (pid), which could have changed
-    const auto pid = m_proxies.key(container);
-    if (pid) {
-        m_proxies.remove(pid);
+        m_priority.remove({it->status, it->order});
+        if (it->proxyPid && m_proxies.value(it->proxyPid) == name) {
+            m_proxies.remove(it->proxyPid);
+        }
+        m_players.erase(it);
     }
 
     if (name == m_activeName) {
+        m_activeName.clear();
         setBestActive();
     }
 
     // When there is no player opened
-    if (m_paused.empty() && m_stopped.empty() && m_playing.empty()) {
+    if (m_players.isEmpty()) {
         Q_EMIT playerListEmptied();
     }
 }
@@ -139,96 +164,81 @@ PlayerContainer *Multiplexer::activePlayer() const
         return nullptr;
     }
 
-    PlayerContainer *container = m_playing.value(m_activeName);
-    if (!container)
-        container = m_paused.value(m_activeName);
-    if (!container)
-        container = m_stopped.value(m_activeName);
+    PlayerContainer *container = m_players.value(m_activeName).container;
     Q_ASSERT(container);
     return container;
 }
 
 void Multiplexer::playerUpdated(const QString &name, const Plasma::DataEngine::Data &newData)
 {
-    Q_UNUSED(name);
     Q_UNUSED(newData);
-    evaluatePlayer(qobject_cast<PlayerContainer *>(sender()));
+    evaluatePlayer(name);
 }
 
-PlayerContainer *Multiplexer::firstPlayerFromHash(const QHash<QString, PlayerContainer *> &hash, PlayerContainer **proxyCandidate) const
+void Multiplexer::setBestActive()
 {
-    if (proxyCandidate) {
-        *proxyCandidate = nullptr;
-    }
-
-    auto it = hash.begin();
-    if (it == hash.end()) {
-        return nullptr;
-    }
-
-    PlayerContainer *container = it.value();
-    const auto containerPid = container->data().value(QStringLiteral("InstancePid")).toUInt();
+    qCDebug(MPRIS2) << "Activating best player";
 
-    // Check if this player is being proxied by someone else and prefer the proxy
-    // but only if it is in the same hash (same state)
-    if (PlayerContainer *proxy = m_proxies.value(containerPid)) {
-        if (std::find(hash.begin(), hash.end(), proxy) == hash.end()) {
-            if (proxyCandidate) {
-                *proxyCandidate = proxy;
-            }
-            return nullptr;
-            // continue;
-        }
-        return proxy;
+    if (m_priority.isEmpty()) {
+        setActive(QString());
+        return;
     }
 
-    return container;
+    const QString best = m_priority.first();
+    const QString proxy = proxyFor(m_players.value(best));
+    setActive(proxy.isEmpty() ? best : proxy);
 }
 
-void Multiplexer::setBestActive()
+void Multiplexer::setActive(const QString &name)
 {
-    qCDebug(MPRIS2) << "Activating best player";
-    PlayerContainer *proxyCandidate = nullptr;
-
-    PlayerContainer *container = firstPlayerFromHash(m_playing, &proxyCandidate);
-    if (!container) {
-        // If we found a proxy earlier, prefer it over a random other player in that category
-        if (proxyCandidate && std::find(m_paused.constBegin(), m_paused.constEnd(), proxyCandidate) != m_paused.constEnd()) {
-            container = proxyCandidate;
-        } else {
-            container = firstPlayerFromHash(m_paused, &proxyCandidate);
-        }
-    }
-    if (!container) {
-        if (proxyCandidate && std::find(m_stopped.constBegin(), m_stopped.constEnd(), proxyCandidate) != m_stopped.constEnd()) {
-            container = proxyCandidate;
-        } else {
-            container = firstPlayerFromHash(m_stopped, &proxyCandidate);
-        }
-    }
+    const bool changed = name != m_activeName;
+    m_activeName = name;
 
+    PlayerContainer *container = m_players.value(name).container;
     if (!container) {
         qCDebug(MPRIS2) << "There is currently no player";
         m_activeName.clear();
         removeAllData();
     } else {
-        m_activeName = container->objectName();
-        qCDebug(MPRIS2) << "Determined" << m_activeName << "to be the best player";
-        replaceData(container->data());
-        checkForUpdate();
+        if (changed) {
+            qCDebug(MPRIS2) << "Switching to" << name;
+        }
+        forwardData(container->data());
     }
 
-    Q_EMIT activePlayerChanged(container);
+    // Recreating the controls for the same player is of no use
+    if (changed) {
+        Q_EMIT activePlayerChanged(container);
+    }
 }
 
-void Multiplexer::replaceData(const Plasma::DataEngine::Data &data)
+void Multiplexer::forwardData(const Plasma::DataEngine::Data &newData)
 {
-    removeAllData();
+    // Only what changed, so that consumers are not updated for nothing
+    const Plasma::DataEngine::Data current = data();
+    bool changed = false;
+
+    for (auto it = current.constBegin(); it != current.constEnd(); ++it) {
+        if (!newData.contains(it.key()) && it.key() != QLatin1String("Source Name")) {
+            setData(it.key(), QVariant());
+            changed = true;
+        }
+    }
+
+    for (auto it = newData.constBegin(); it != newData.constEnd(); ++it) {
+        auto currentIt = current.constFind(it.key());
+        if (currentIt == current.constEnd() || *currentIt != *it) {
+            setData(it.key(), *it);
+            changed = true;
+        }
+    }
+
+    if (current.value(QStringLiteral("Source Name")).toString() != m_activeName) {
+        setData(QStringLiteral("Source Name"), m_activeName);
+        changed = true;
+    }
 
-    Plasma::DataEngine::Data::const_iterator it = data.constBegin();
-    while (it != data.constEnd()) {
-        setData(it.key(), it.value());
-        ++it;
+    if (changed) {
+        checkForUpdate();
     }
-    setData(QStringLiteral("Source Name"), m_activeName);
 }
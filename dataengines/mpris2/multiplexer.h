@@ -10,7 +10,8 @@
 
 #include "playercontainer.h"
 
-#include <QWeakPointer>
+#include <QHash>
+#include <QMap>
 
 class Multiplexer : public Plasma::DataContainer
 {
@@ -39,15 +40,48 @@ private Q_SLOTS:
     void playerUpdated(const QString &name, const Plasma::DataEngine::Data &data);
 
 private:
-    void evaluatePlayer(PlayerContainer *container);
+    enum Status {
+        Playing,
+        Paused,
+        Stopped,
+    };
+
+    struct PlayerInfo {
+        PlayerContainer *container = nullptr;
+        Status status = Stopped;
+        // When the status last changed, higher is more recent
+        quint64 order = 0;
+        // kde:pid, the process whose player this one is a proxy for
+        uint proxyPid = 0;
+        uint instancePid = 0;
+        // As last seen, comparing is cheap as long as it is shared with the container's
+        QVariantMap metadata;
+    };
+
+    // Better players first: by status, then the most recently changed one
+    struct PriorityKey {
+        Status status;
+        quint64 order;
+
+        bool operator<(const PriorityKey &other) const
+        {
+            return status != other.status ? status < other.status : order > other.order;
+        }
+    };
+
+    // Returns whether the status changed, or the player was not known before
+    bool updatePlayerInfo(PlayerInfo &info);
+    QString proxyFor(const PlayerInfo &info) const;
+    void evaluatePlayer(const QString &name);
     void setBestActive();
-    void replaceData(const Plasma::DataEngine::Data &data);
-    PlayerContainer *firstPlayerFromHash(const QHash<QString, PlayerContainer *> &hash, PlayerContainer **proxyCandidate) const;
+    void setActive(const QString &name);
+    void forwardData(const Plasma::DataEngine::Data &data);
 
     QString m_activeName;
-    QHash<QString, PlayerContainer *> m_playing;
-    QHash<QString, PlayerContainer *> m_paused;
-    QHash<QString, PlayerContainer *> m_stopped;
+    QHash<QString, PlayerInfo> m_players;
+    QMap<PriorityKey, QString> m_priority;
+    quint64 m_order = 0;
 
-    QHash<qlonglong, PlayerContainer *> m_proxies;
+    // Instance pid to the name of the player proxying for it
+    QHash<uint, QString> m_proxies;
 };
@@ -16,6 +16,7 @@
 #include <KDesktopFile>
 
 #include <QDBusConnection>
+#include <QDBusObjectPath>
 #include <QDateTime>
 
 #include "debug.h"
@@ -213,11 +214,10 @@ void PlayerContainer::copyProperty(const QString &propName, const QVariant &_val
 
         } else if (propName == QLatin1String("Metadata")) {
             if (updType == UpdatedSignal) {
-                const QString oldTrackId = data().value(QStringLiteral("Metadata")).toMap().value(QStringLiteral("mpris:trackid")).toString();
-                const QString newTrackId = value.toMap().value(QStringLiteral("mpris:trackid")).toString();
-                if (oldTrackId != newTrackId) {
+                if (isNewTrack(data().value(QStringLiteral("Metadata")).toMap(), value.toMap())) {
                     setData(QStringLiteral("Position"), static_cast<qlonglong>(0));
                     setData(POS_UPD_STRING, QDateTime::currentDateTimeUtc());
+                    syncPosition();
                 }
             }
 
@@ -228,13 +228,17 @@ void PlayerContainer::copyProperty(const QString &propName, const QVariant &_val
             }
 
         } else if (propName == QLatin1String("Rate") && data().value(QStringLiteral("PlaybackStatus")).toString() == QLatin1String("Playing")) {
-            if (data().contains(QLatin1String("Position")))
+            if (data().contains(QLatin1String("Position"))) {
                 recalculatePosition();
+                syncPosition();
+            }
             m_currentRate = value.toDouble();
 
         } else if (propName == QLatin1String("PlaybackStatus")) {
             if (data().contains(QLatin1String("Position")) && data().contains(QLatin1String("PlaybackStatus"))) {
-                updatePosition();
+                // Up to now at the old rate, until the player tells where it actually is
+                recalculatePosition();
+                syncPosition();
             }
 
             // update the effective rate
@@ -332,6 +336,44 @@ void PlayerContainer::getPropsFinished(QDBusPendingCallWatcher *watcher)
 }
 
 void PlayerContainer::updatePosition()
+{
+    // Position changes continuously without any signal, but predictably: consumers
+    // extrapolate from the last known position, its time and the rate, which is
+    // synced with the player whenever that changes in some other way
+    if (!data().contains(QLatin1String("Position"))) {
+        syncPosition();
+        return;
+    }
+
+    recalculatePosition();
+    checkForUpdate();
+}
+
+bool PlayerContainer::isNewTrack(const QVariantMap &oldMetadata, const QVariantMap &newMetadata)
+{
+    auto trackId = [](const QVariantMap &metadata) {
+        const QVariant mprisTrackId = metadata.value(QStringLiteral("mpris:trackid"));
+        if (mprisTrackId.canConvert<QDBusObjectPath>()) {
+            return mprisTrackId.value<QDBusObjectPath>().path();
+        }
+        return mprisTrackId.toString();
+    };
+
+    // a length that is not positive is dropped, as if there was none
+    auto length = [](const QVariantMap &metadata) {
+        return qMax(metadata.value(QStringLiteral("mpris:length")).toLongLong(), 0LL);
+    };
+
+    auto entry = [](const QVariantMap &metadata, const QString &key) {
+        return metadata.value(key).toString();
+    };
+
+    return trackId(oldMetadata) != trackId(newMetadata) || length(oldMetadata) != length(newMetadata)
+        || entry(oldMetadata, QStringLiteral("xesam:url")) != entry(newMetadata, QStringLiteral("xesam:url"))
+        || entry(oldMetadata, QStringLiteral("xesam:title")) != entry(newMetadata, QStringLiteral("xesam:title"));
+}
+
+void PlayerContainer::syncPosition()
 {
     QDBusPendingCall async = m_propsIface->Get(OrgMprisMediaPlayer2PlayerInterface::staticInterfaceName(), QStringLiteral("Position"));
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(async, this);
@@ -381,6 +423,13 @@ void PlayerContainer::recalculatePosition()
     QDateTime now = QDateTime::currentDateTimeUtc();
     qint64 diff = lastUpdated.msecsTo(now) * 1000;
     qint64 newPos = pos + static_cast<qint64>(diff * m_currentRate);
+
+    // Playing on from the end of a track takes another track, which is announced
+    const qint64 length = data().value(QStringLiteral("Metadata")).toMap().value(QStringLiteral("mpris:length")).toLongLong();
+    if (length > 0) {
+        newPos = qMin(newPos, length);
+    }
+
     setData(QStringLiteral("Position"), newPos);
     setData(POS_UPD_STRING, now);
 }
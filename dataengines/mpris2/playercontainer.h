@@ -65,8 +65,19 @@ public:
     };
 
     void refresh();
+    /**
+     * Publishes the position extrapolated to now, asking the player only if it is not known yet
+     */
     void updatePosition();
 
+    /**
+     * Whether going from @p oldMetadata to @p newMetadata means another track is playing
+     *
+     * Not all players give each track its own mpris:trackid, so the length, URL and title
+     * are compared too.
+     */
+    static bool isNewTrack(const QVariantMap &oldMetadata, const QVariantMap &newMetadata);
+
 Q_SIGNALS:
     void initialFetchFinished(PlayerContainer *self);
     void initialFetchFailed(PlayerContainer *self);
@@ -82,6 +93,7 @@ private:
     void copyProperty(const QString &propName, const QVariant &value, QVariant::Type expType, UpdateType updType);
     void updateFromMap(const QVariantMap &map, UpdateType updType);
     void recalculatePosition();
+    void syncPosition();
 
     Caps m_caps;
     int m_fetchesPending;
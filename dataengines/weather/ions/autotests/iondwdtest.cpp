@@ -0,0 +1,102 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include <Plasma/DataContainer>
+
+#include "../dwd/ion_dwd.h"
+
+// Runs the DWD ion on responses recorded with PLASMA_WEATHER_RECORD_DIR, see data/dwd/index.txt
+class IonDwdTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testValidate_data();
+    void testValidate();
+    void testWeather();
+
+private:
+    QVariant value(const QString &source, const QString &key) const;
+
+    DWDIon *m_ion = nullptr;
+};
+
+void IonDwdTest::initTestCase()
+{
+    const QString fixtures = QFINDTESTDATA("data/dwd/index.txt");
+    QVERIFY(!fixtures.isEmpty());
+    qputenv("PLASMA_WEATHER_REPLAY_DIR", QFile::encodeName(QFileInfo(fixtures).path()));
+
+    m_ion = new DWDIon(this, QVariantList());
+}
+
+QVariant IonDwdTest::value(const QString &source, const QString &key) const
+{
+    Plasma::DataContainer *container = m_ion->containerForSource(source);
+    return container ? container->data().value(key) : QVariant();
+}
+
+void IonDwdTest::testValidate_data()
+{
+    QTest::addColumn<QString>("search");
+    QTest::addColumn<QString>("expected");
+
+    // The first search parses the station catalogue, the others use what it found
+    QTest::newRow("single") << QStringLiteral("tegel") << QStringLiteral("dwd|valid|single|place|Berlin-Tegel|extra|10382");
+    QTest::newRow("multiple") << QStringLiteral("Berlin")
+                              << QStringLiteral(
+                                     "dwd|valid|multiple|place|Berlin-Brandenburg|extra|10381|place|Berlin-Tegel|extra|10382|place|Berlin-Tempelhof|extra|10384");
+    QTest::newRow("foreign station") << QStringLiteral("poitiers") << QStringLiteral("dwd|valid|single|place|Poitiers|extra|07335");
+    // Only ids starting with 0 or 1 are known to work
+    QTest::newRow("unsupported id") << QStringLiteral("hamburg") << QStringLiteral("dwd|invalid|multiple|hamburg");
+    QTest::newRow("unknown") << QStringLiteral("atlantis") << QStringLiteral("dwd|invalid|multiple|atlantis");
+}
+
+void IonDwdTest::testValidate()
+{
+    QFETCH(QString, search);
+    QFETCH(QString, expected);
+
+    const QString source = QStringLiteral("dwd|validate|") + search;
+    QVERIFY(m_ion->updateIonSource(source));
+
+    QTRY_COMPARE(value(source, QStringLiteral("validate")).toString(), expected);
+}
+
+void IonDwdTest::testWeather()
+{
+    const QString source = QStringLiteral("dwd|weather|Berlin-Tegel|10382");
+    QVERIFY(m_ion->updateIonSource(source));
+
+    // Set once both the forecast and the measurements are in
+    QTRY_VERIFY(value(source, QStringLiteral("Credit")).isValid());
+
+    // Current measurements, in tenths
+    QCOMPARE(value(source, QStringLiteral("Temperature")).toFloat(), 12.5f);
+    QCOMPARE(value(source, QStringLiteral("Humidity")).toFloat(), 87.0f);
+    QCOMPARE(value(source, QStringLiteral("Pressure")).toFloat(), 1012.3f);
+    QCOMPARE(value(source, QStringLiteral("Dewpoint")).toFloat(), 10.4f);
+    QCOMPARE(value(source, QStringLiteral("Wind Speed")).toFloat(), 14.8f);
+    QCOMPARE(value(source, QStringLiteral("Wind Gust Speed")).toFloat(), 35.2f);
+    QCOMPARE(value(source, QStringLiteral("Wind Direction")).toString(), QStringLiteral("SW"));
+    QCOMPARE(value(source, QStringLiteral("Condition Icon")).toString(), QStringLiteral("weather-clouds"));
+    QCOMPARE(value(source, QStringLiteral("Observation Timestamp")).toDateTime(), QDateTime::fromMSecsSinceEpoch(1760868000000));
+
+    // The forecast has eight days, only a week of them is shown
+    QCOMPARE(value(source, QStringLiteral("Total Weather Days")).toInt(), 7);
+    QCOMPARE(value(source, QStringLiteral("Short Forecast Day 0")).toString(), QStringLiteral("Today|weather-clouds||14.3|5.2|"));
+
+    QCOMPARE(value(source, QStringLiteral("Total Warnings Issued")).toInt(), 1);
+    QCOMPARE(value(source, QStringLiteral("Warning Priority 0")).toInt(), 2);
+    QVERIFY(value(source, QStringLiteral("Warning Description 0")).toString().startsWith(QStringLiteral("Es treten oberhalb 1000 m Sturmböen")));
+}
+
+QTEST_GUILESS_MAIN(IonDwdTest)
+
+#include "iondwdtest.moc"
@@ -0,0 +1,103 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "../ionfetchjob.h"
+
+class IonFetchJobTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testExpiry_data();
+    void testExpiry();
+    void testReplay();
+    void testReplayMissing();
+
+private:
+    QTemporaryDir m_fixtures;
+};
+
+void IonFetchJobTest::initTestCase()
+{
+    QVERIFY(m_fixtures.isValid());
+    qputenv("PLASMA_WEATHER_REPLAY_DIR", QFile::encodeName(m_fixtures.path()));
+}
+
+void IonFetchJobTest::testExpiry_data()
+{
+    QTest::addColumn<QString>("headers");
+    QTest::addColumn<qint64>("expected");
+
+    QTest::newRow("none") << QString() << qint64(-1);
+    QTest::newRow("max-age") << QStringLiteral("Content-Type: text/xml\nCache-Control: public, max-age=600\n") << qint64(600);
+    QTest::newRow("max-age and age") << QStringLiteral("cache-control: max-age=600\nAge: 100") << qint64(500);
+    QTest::newRow("too old") << QStringLiteral("Cache-Control: max-age=600\nAge: 700") << qint64(-1);
+    QTest::newRow("no-store") << QStringLiteral("Cache-Control: no-store, max-age=600") << qint64(-1);
+    QTest::newRow("expires") << QStringLiteral("Expires: Thu, 01 Jan 2026 01:00:00 +0000") << qint64(3600);
+    QTest::newRow("expired") << QStringLiteral("Expires: Wed, 31 Dec 2025 23:00:00 +0000") << qint64(-1);
+    QTest::newRow("max-age over expires") << QStringLiteral("Expires: Thu, 01 Jan 2026 01:00:00 +0000\nCache-Control: max-age=60") << qint64(60);
+}
+
+void IonFetchJobTest::testExpiry()
+{
+    QFETCH(QString, headers);
+    QFETCH(qint64, expected);
+
+    const QDateTime now(QDate(2026, 1, 1), QTime(0, 0), Qt::UTC);
+    const QDateTime expiry = IonFetchJob::expiry(headers, now);
+
+    if (expected < 0) {
+        QVERIFY(!expiry.isValid());
+    } else {
+        QCOMPARE(now.secsTo(expiry), expected);
+    }
+}
+
+void IonFetchJobTest::testReplay()
+{
+    const QUrl url(QStringLiteral("https://weather.example.org/forecast?station=42"));
+    const QByteArray body("<forecast><temperature>12</temperature></forecast>");
+
+    QFile fixture(m_fixtures.filePath(IonFetchJob::fileName(url)));
+    QVERIFY(fixture.open(QIODevice::WriteOnly));
+    fixture.write(body);
+    fixture.close();
+
+    IonFetchJob *job = IonFetchJob::get(url);
+    job->setAutoDelete(false);
+    QSignalSpy dataSpy(job, &IonFetchJob::data);
+    QSignalSpy resultSpy(job, &KJob::result);
+
+    QVERIFY(resultSpy.wait());
+    QCOMPARE(job->error(), 0);
+    QCOMPARE(dataSpy.count(), 1);
+    QCOMPARE(dataSpy.first().at(1).toByteArray(), body);
+
+    delete job;
+}
+
+void IonFetchJobTest::testReplayMissing()
+{
+    IonFetchJob *job = IonFetchJob::get(QUrl(QStringLiteral("https://weather.example.org/unknown")));
+    job->setAutoDelete(false);
+    QSignalSpy dataSpy(job, &IonFetchJob::data);
+    QSignalSpy resultSpy(job, &KJob::result);
+
+    QVERIFY(resultSpy.wait());
+    QVERIFY(job->error() != 0);
+    QCOMPARE(dataSpy.count(), 0);
+
+    delete job;
+}
+
+QTEST_GUILESS_MAIN(IonFetchJobTest)
+
+#include "ionfetchjobtest.moc"
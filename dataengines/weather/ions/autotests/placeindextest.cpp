@@ -0,0 +1,101 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include "../ion.h"
+
+class PlaceIndexTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testNormalize();
+    void testSearch_data();
+    void testSearch();
+    void testRanking();
+    void benchmarkSearch();
+
+private:
+    PlaceIndex m_index;
+};
+
+void PlaceIndexTest::initTestCase()
+{
+    m_index.insert(QStringLiteral("Montréal, QC"));
+    m_index.insert(QStringLiteral("Mont-Laurier, QC"));
+    m_index.insert(QStringLiteral("Lac-Mégantic, QC"));
+    m_index.insert(QStringLiteral("Toronto, ON"));
+    m_index.insert(QStringLiteral("Toronto Island, ON"));
+    m_index.insert(QStringLiteral("Port Hope, ON"));
+    m_index.insert(QStringLiteral("Newport, RI"));
+    // Duplicates are ignored
+    m_index.insert(QStringLiteral("Toronto, ON"));
+
+    QCOMPARE(m_index.count(), 7);
+}
+
+void PlaceIndexTest::testNormalize()
+{
+    QCOMPARE(PlaceIndex::normalize(QStringLiteral("Montréal")), QStringLiteral("montreal"));
+    QCOMPARE(PlaceIndex::normalize(QStringLiteral("MÉGANTIC")), QStringLiteral("megantic"));
+    QCOMPARE(PlaceIndex::normalize(QStringLiteral("ÅLESUND")), QStringLiteral("alesund"));
+}
+
+void PlaceIndexTest::testSearch_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("exact") << QStringLiteral("Toronto, ON") << QStringList{QStringLiteral("Toronto, ON")};
+    QTest::newRow("case") << QStringLiteral("TORONTO, on") << QStringList{QStringLiteral("Toronto, ON")};
+    QTest::newRow("diacritics in query") << QStringLiteral("mégantic") << QStringList{QStringLiteral("Lac-Mégantic, QC")};
+    QTest::newRow("diacritics in place") << QStringLiteral("montreal") << QStringList{QStringLiteral("Montréal, QC")};
+    QTest::newRow("short") << QStringLiteral("ON")
+                           << QStringList{QStringLiteral("Port Hope, ON"),
+                                          QStringLiteral("Toronto Island, ON"),
+                                          QStringLiteral("Toronto, ON"),
+                                          QStringLiteral("Mont-Laurier, QC"),
+                                          QStringLiteral("Montréal, QC")};
+    QTest::newRow("n-grams apart") << QStringLiteral("torisland") << QStringList{};
+    QTest::newRow("none") << QStringLiteral("Vancouver") << QStringList{};
+}
+
+void PlaceIndexTest::testSearch()
+{
+    QFETCH(QString, query);
+    QFETCH(QStringList, expected);
+
+    QCOMPARE(m_index.search(query), expected);
+}
+
+void PlaceIndexTest::testRanking()
+{
+    // Start of the name, then start of a word, then anywhere
+    QCOMPARE(m_index.search(QStringLiteral("port")), (QStringList{QStringLiteral("Port Hope, ON"), QStringLiteral("Newport, RI")}));
+    QCOMPARE(m_index.search(QStringLiteral("mont")),
+             (QStringList{QStringLiteral("Mont-Laurier, QC"), QStringLiteral("Montréal, QC")}));
+    QCOMPARE(m_index.search(QStringLiteral("toronto")), (QStringList{QStringLiteral("Toronto Island, ON"), QStringLiteral("Toronto, ON")}));
+    QCOMPARE(m_index.search(QStringLiteral("island")), QStringList{QStringLiteral("Toronto Island, ON")});
+}
+
+void PlaceIndexTest::benchmarkSearch()
+{
+    PlaceIndex index;
+    for (int i = 0; i < 10000; ++i) {
+        index.insert(QStringLiteral("Station %1, Region %2").arg(i).arg(i % 50));
+    }
+    index.insert(QStringLiteral("Saint-Jean-sur-Richelieu, QC"));
+
+    QBENCHMARK {
+        QCOMPARE(index.search(QStringLiteral("richel")).size(), 1);
+    }
+}
+
+QTEST_GUILESS_MAIN(PlaceIndexTest)
+
+#include "placeindextest.moc"
@@ -9,8 +9,9 @@
 #include "ion_bbcukmet.h"
 
 #include "ion_bbcukmetdebug.h"
+#include "../ionfetchjob.h"
 
-#include <KIO/Job>
+#include <KIO/Global>
 #include <KLocalizedString>
 #include <KUnitConversion/Converter>
 
@@ -289,12 +290,12 @@ void UKMETIon::getXMLData(const QString &source)
 
     const QUrl url(QStringLiteral("https://weather-broker-cdn.api.bbci.co.uk/en/observation/rss/") + m_place[source].stationId);
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
     getJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none")); // Disable displaying cookies
     m_obsJobXml.insert(getJob, new QXmlStreamReader);
     m_obsJobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &UKMETIon::observation_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &UKMETIon::observation_slotDataArrived);
     connect(getJob, &KJob::result, this, &UKMETIon::observation_slotJobFinished);
 }
 
@@ -312,19 +313,19 @@ void UKMETIon::findPlace(const QString &place, const QString &source)
     m_normalSearchArrived = false;
     m_autoSearchArrived = false;
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
     getJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none")); // Disable displaying cookies
     m_jobHtml.insert(getJob, new QByteArray());
     m_jobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &UKMETIon::setup_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &UKMETIon::setup_slotDataArrived);
 
-    KIO::TransferJob *autoGetJob = KIO::get(autoUrl, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *autoGetJob = IonFetchJob::get(autoUrl);
     autoGetJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none")); // Disable displaying cookies
     m_jobHtml.insert(autoGetJob, new QByteArray());
     m_jobList.insert(autoGetJob, source);
 
-    connect(autoGetJob, &KIO::TransferJob::data, this, &UKMETIon::setup_slotDataArrived);
+    connect(autoGetJob, &IonFetchJob::data, this, &UKMETIon::setup_slotDataArrived);
 
     connect(getJob, &KJob::result, this, [&](KJob *job) {
         setup_slotJobFinished(job, QStringLiteral("normal"));
@@ -340,12 +341,12 @@ void UKMETIon::getFiveDayForecast(const QString &source)
 
     const QUrl url(QStringLiteral("https://weather-broker-cdn.api.bbci.co.uk/en/forecast/rss/3day/") + place.stationId);
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
     getJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none")); // Disable displaying cookies
     m_forecastJobXml.insert(getJob, new QXmlStreamReader);
     m_forecastJobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &UKMETIon::forecast_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &UKMETIon::forecast_slotDataArrived);
     connect(getJob, &KJob::result, this, &UKMETIon::forecast_slotJobFinished);
 }
 
@@ -415,7 +416,7 @@ void UKMETIon::parseUnknownElement(QXmlStreamReader &xml) const
     }
 }
 
-void UKMETIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void UKMETIon::setup_slotDataArrived(KJob *job, const QByteArray &data)
 {
     if (data.isEmpty() || !m_jobHtml.contains(job)) {
         return;
@@ -457,7 +458,7 @@ void UKMETIon::setup_slotJobFinished(KJob *job, const QString &type)
     m_jobHtml.clear();
 }
 
-void UKMETIon::observation_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void UKMETIon::observation_slotDataArrived(KJob *job, const QByteArray &data)
 {
     QByteArray local = data;
     if (data.isEmpty() || !m_obsJobXml.contains(job)) {
@@ -488,7 +489,7 @@ void UKMETIon::observation_slotJobFinished(KJob *job)
     }
 }
 
-void UKMETIon::forecast_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void UKMETIon::forecast_slotDataArrived(KJob *job, const QByteArray &data)
 {
     QByteArray local = data;
     if (data.isEmpty() || !m_forecastJobXml.contains(job)) {
@@ -16,11 +16,6 @@
 #include <QVector>
 
 class KJob;
-namespace KIO
-{
-class Job;
-class TransferJob;
-}
 class QXmlStreamReader;
 
 class WeatherData
@@ -91,14 +86,14 @@ protected: // IonInterface API
     void reset() override;
 
 private Q_SLOTS:
-    void setup_slotDataArrived(KIO::Job *, const QByteArray &);
+    void setup_slotDataArrived(KJob *, const QByteArray &);
     void setup_slotJobFinished(KJob *, const QString &);
     // void setup_slotRedirected(KIO::Job *, const KUrl &url);
 
-    void observation_slotDataArrived(KIO::Job *, const QByteArray &);
+    void observation_slotDataArrived(KJob *, const QByteArray &);
     void observation_slotJobFinished(KJob *);
 
-    void forecast_slotDataArrived(KIO::Job *, const QByteArray &);
+    void forecast_slotDataArrived(KJob *, const QByteArray &);
     void forecast_slotJobFinished(KJob *);
 
 private:
@@ -17,8 +17,8 @@
 #include "ion_dwd.h"
 
 #include "ion_dwddebug.h"
+#include "../ionfetchjob.h"
 
-#include <KIO/Job>
 #include <KLocalizedString>
 #include <KUnitConversion/Converter>
 
@@ -192,13 +192,13 @@ void DWDIon::findPlace(const QString &searchText)
         searchInStationList(searchText);
     } else {
         const QUrl forecastURL(QStringLiteral(CATALOGUE_URL));
-        KIO::TransferJob *getJob = KIO::get(forecastURL, KIO::Reload, KIO::HideProgressInfo);
+        IonFetchJob *getJob = IonFetchJob::get(forecastURL);
         getJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none"));
 
         m_searchJobList.insert(getJob, searchText);
         m_searchJobData.insert(getJob, QByteArray(""));
 
-        connect(getJob, &KIO::TransferJob::data, this, &DWDIon::setup_slotDataArrived);
+        connect(getJob, &IonFetchJob::data, this, &DWDIon::setup_slotDataArrived);
         connect(getJob, &KJob::result, this, &DWDIon::setup_slotJobFinished);
     }
 }
@@ -215,7 +215,7 @@ void DWDIon::fetchWeather(QString placeName, QString placeID)
     // Fetch forecast data
 
     const QUrl forecastURL(QStringLiteral(FORECAST_URL).arg(placeID));
-    KIO::TransferJob *getJob = KIO::get(forecastURL, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(forecastURL);
     getJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none"));
 
     m_forecastJobList.insert(getJob, placeName);
@@ -223,14 +223,14 @@ void DWDIon::fetchWeather(QString placeName, QString placeID)
 
     qCDebug(IONENGINE_dwd) << "Requesting URL: " << forecastURL;
 
-    connect(getJob, &KIO::TransferJob::data, this, &DWDIon::forecast_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &DWDIon::forecast_slotDataArrived);
     connect(getJob, &KJob::result, this, &DWDIon::forecast_slotJobFinished);
     m_weatherData[placeName].isForecastsDataPending = true;
 
     // Fetch current measurements (different url AND different API, AMAZING)
 
     const QUrl measureURL(QStringLiteral(MEASURE_URL).arg(placeID));
-    KIO::TransferJob *getMeasureJob = KIO::get(measureURL, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getMeasureJob = IonFetchJob::get(measureURL);
     getMeasureJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none"));
 
     m_measureJobList.insert(getMeasureJob, placeName);
@@ -238,12 +238,12 @@ void DWDIon::fetchWeather(QString placeName, QString placeID)
 
     qCDebug(IONENGINE_dwd) << "Requesting URL: " << measureURL;
 
-    connect(getMeasureJob, &KIO::TransferJob::data, this, &DWDIon::measure_slotDataArrived);
+    connect(getMeasureJob, &IonFetchJob::data, this, &DWDIon::measure_slotDataArrived);
     connect(getMeasureJob, &KJob::result, this, &DWDIon::measure_slotJobFinished);
     m_weatherData[placeName].isMeasureDataPending = true;
 }
 
-void DWDIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void DWDIon::setup_slotDataArrived(KJob *job, const QByteArray &data)
 {
     QByteArray local = data;
 
@@ -254,7 +254,7 @@ void DWDIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
     m_searchJobData[job].append(local);
 }
 
-void DWDIon::measure_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void DWDIon::measure_slotDataArrived(KJob *job, const QByteArray &data)
 {
     QByteArray local = data;
 
@@ -265,7 +265,7 @@ void DWDIon::measure_slotDataArrived(KIO::Job *job, const QByteArray &data)
     m_measureJobJSON[job].append(local);
 }
 
-void DWDIon::forecast_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void DWDIon::forecast_slotDataArrived(KJob *job, const QByteArray &data)
 {
     QByteArray local = data;
 
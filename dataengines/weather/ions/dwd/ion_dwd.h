@@ -25,11 +25,6 @@
 #define MEASURE_URL "https://s3.eu-central-1.amazonaws.com/app-prod-static.warnwetter.de/v16/current_measurement_%1.json"
 
 class KJob;
-namespace KIO
-{
-class Job;
-class TransferJob;
-}
 
 class WeatherData
 {
@@ -98,13 +93,13 @@ protected: // IonInterface API
     void reset() override;
 
 private Q_SLOTS:
-    void setup_slotDataArrived(KIO::Job *, const QByteArray &);
+    void setup_slotDataArrived(KJob *, const QByteArray &);
     void setup_slotJobFinished(KJob *);
 
-    void measure_slotDataArrived(KIO::Job *, const QByteArray &);
+    void measure_slotDataArrived(KJob *, const QByteArray &);
     void measure_slotJobFinished(KJob *);
 
-    void forecast_slotDataArrived(KIO::Job *, const QByteArray &);
+    void forecast_slotDataArrived(KJob *, const QByteArray &);
     void forecast_slotJobFinished(KJob *);
 
 private:
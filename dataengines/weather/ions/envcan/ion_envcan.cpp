@@ -9,8 +9,8 @@
 #include "ion_envcan.h"
 
 #include "ion_envcandebug.h"
+#include "../ionfetchjob.h"
 
-#include <KIO/Job>
 #include <KLocalizedString>
 #include <KUnitConversion/Converter>
 
@@ -443,16 +443,12 @@ QStringList EnvCanadaIon::validate(const QString &source) const
 {
     QStringList placeList;
 
-    QString sourceNormalized = source.toUpper();
-    QHash<QString, EnvCanadaIon::XMLMapInfo>::const_iterator it = m_places.constBegin();
-    while (it != m_places.constEnd()) {
-        if (it.key().toUpper().contains(sourceNormalized)) {
-            placeList.append(QStringLiteral("place|") + it.key());
-        }
-        ++it;
+    const QStringList places = m_placeIndex.search(source);
+    placeList.reserve(places.size());
+    for (const QString &place : places) {
+        placeList.append(QStringLiteral("place|") + place);
     }
 
-    placeList.sort();
     return placeList;
 }
 
@@ -500,10 +496,10 @@ void EnvCanadaIon::getXMLSetup()
 
     const QUrl url(QStringLiteral("http://dd.weather.gc.ca/citypage_weather/xml/siteList.xml"));
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::NoReload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url, KIO::NoReload);
 
     m_xmlSetup.clear();
-    connect(getJob, &KIO::TransferJob::data, this, &EnvCanadaIon::setup_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &EnvCanadaIon::setup_slotDataArrived);
     connect(getJob, &KJob::result, this, &EnvCanadaIon::setup_slotJobFinished);
 }
 
@@ -534,16 +530,16 @@ void EnvCanadaIon::getXMLData(const QString &source)
         return;
     }
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
 
     m_jobXml.insert(getJob, new QXmlStreamReader);
     m_jobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &EnvCanadaIon::slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &EnvCanadaIon::slotDataArrived);
     connect(getJob, &KJob::result, this, &EnvCanadaIon::slotJobFinished);
 }
 
-void EnvCanadaIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void EnvCanadaIon::setup_slotDataArrived(KJob *job, const QByteArray &data)
 {
     Q_UNUSED(job)
 
@@ -557,7 +553,7 @@ void EnvCanadaIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
     m_xmlSetup.addData(data);
 }
 
-void EnvCanadaIon::slotDataArrived(KIO::Job *job, const QByteArray &data)
+void EnvCanadaIon::slotDataArrived(KJob *job, const QByteArray &data)
 {
     if (data.isEmpty() || !m_jobXml.contains(job)) {
         return;
@@ -643,6 +639,7 @@ bool EnvCanadaIon::readXMLSetup()
 
             // Set the string list, we will use for the applet to display the available cities.
             m_places[tmp] = info;
+            m_placeIndex.insert(tmp);
             success = true;
         }
     }
@@ -16,10 +16,6 @@
 #include <QXmlStreamReader>
 
 class KJob;
-namespace KIO
-{
-class Job;
-} // namespace KIO
 
 class WeatherData
 {
@@ -150,10 +146,10 @@ protected: // IonInterface API
     void reset() override;
 
 private Q_SLOTS:
-    void setup_slotDataArrived(KIO::Job *, const QByteArray &);
+    void setup_slotDataArrived(KJob *, const QByteArray &);
     void setup_slotJobFinished(KJob *);
 
-    void slotDataArrived(KIO::Job *, const QByteArray &);
+    void slotDataArrived(KJob *, const QByteArray &);
     void slotJobFinished(KJob *);
 
 private:
@@ -213,6 +209,7 @@ private:
 
     // Key dicts
     QHash<QString, EnvCanadaIon::XMLMapInfo> m_places;
+    PlaceIndex m_placeIndex;
 
     // Weather information
     QHash<QString, WeatherData> m_weatherData;
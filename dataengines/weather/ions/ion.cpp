@@ -10,6 +10,8 @@
 
 #include <KLocalizedString>
 
+#include <algorithm>
+
 class Q_DECL_HIDDEN IonInterface::Private
 {
 public:
@@ -212,3 +214,174 @@ QString IonInterface::getWeatherIcon(const QMap<QString, ConditionIcons> &condit
 {
     return getWeatherIcon(conditionList[condition.toLower()]);
 }
+
+class Q_DECL_HIDDEN PlaceIndex::Private
+{
+public:
+    // Longest n-grams indexed, shorter queries are answered from the index alone
+    static const int gramLength = 3;
+
+    void index(int id, const QString &key);
+    QVector<int> candidates(const QString &query) const;
+
+    QStringList places;
+    QVector<QString> keys;
+    QHash<QString, int> ids;
+    // n-gram to the places containing it, in ascending order
+    QHash<QString, QVector<int>> postings;
+};
+
+void PlaceIndex::Private::index(int id, const QString &key)
+{
+    for (int length = 1; length <= gramLength; ++length) {
+        for (int i = 0; i + length <= key.size(); ++i) {
+            QVector<int> &posting = postings[key.mid(i, length)];
+            // Once per place, even if the n-gram occurs several times in its name
+            if (posting.isEmpty() || posting.constLast() != id) {
+                posting.append(id);
+            }
+        }
+    }
+}
+
+QVector<int> PlaceIndex::Private::candidates(const QString &query) const
+{
+    if (query.size() <= gramLength) {
+        return postings.value(query);
+    }
+
+    QVector<const QVector<int> *> lists;
+    for (int i = 0; i + gramLength <= query.size(); ++i) {
+        auto it = postings.constFind(query.mid(i, gramLength));
+        if (it == postings.constEnd()) {
+            return {};
+        }
+        lists.append(&*it);
+    }
+
+    // Starting with the rarest n-gram keeps the intersections small
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+
+    QVector<int> result = *lists.constFirst();
+    QVector<int> intersection;
+    for (int i = 1; i < lists.size() && !result.isEmpty(); ++i) {
+        intersection.clear();
+        std::set_intersection(result.cbegin(), result.cend(), lists.at(i)->cbegin(), lists.at(i)->cend(), std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+
+    return result;
+}
+
+PlaceIndex::PlaceIndex()
+    : d(new Private)
+{
+}
+
+PlaceIndex::~PlaceIndex()
+{
+    delete d;
+}
+
+void PlaceIndex::clear()
+{
+    d->places.clear();
+    d->keys.clear();
+    d->ids.clear();
+    d->postings.clear();
+}
+
+void PlaceIndex::insert(const QString &place)
+{
+    if (d->ids.contains(place)) {
+        return;
+    }
+
+    const int id = d->places.size();
+    const QString key = normalize(place);
+
+    d->places.append(place);
+    d->keys.append(key);
+    d->ids.insert(place, id);
+    d->index(id, key);
+}
+
+int PlaceIndex::count() const
+{
+    return d->places.size();
+}
+
+QStringList PlaceIndex::search(const QString &query) const
+{
+    const QString normalizedQuery = normalize(query);
+
+    // Everything contains nothing
+    if (normalizedQuery.isEmpty()) {
+        QStringList places = d->places;
+        places.sort();
+        return places;
+    }
+
+    struct Match {
+        int rank;
+        int id;
+    };
+    QVector<Match> matches;
+
+    const QVector<int> candidates = d->candidates(normalizedQuery);
+    for (int id : candidates) {
+        const QString &key = d->keys.at(id);
+
+        int position = key.indexOf(normalizedQuery);
+        // The n-grams of longer queries may occur apart from each other
+        if (position < 0) {
+            continue;
+        }
+
+        int rank = 3;
+        if (position == 0) {
+            rank = key.size() == normalizedQuery.size() ? 0 : 1;
+        } else {
+            for (; position > 0; position = key.indexOf(normalizedQuery, position + 1)) {
+                if (!key.at(position - 1).isLetterOrNumber()) {
+                    rank = 2;
+                    break;
+                }
+            }
+        }
+
+        matches.append({rank, id});
+    }
+
+    std::sort(matches.begin(), matches.end(), [this](const Match &a, const Match &b) {
+        if (a.rank != b.rank) {
+            return a.rank < b.rank;
+        }
+        return d->places.at(a.id) < d->places.at(b.id);
+    });
+
+    QStringList places;
+    places.reserve(matches.size());
+    for (const Match &match : qAsConst(matches)) {
+        places.append(d->places.at(match.id));
+    }
+
+    return places;
+}
+
+QString PlaceIndex::normalize(const QString &text)
+{
+    const QString decomposed = text.normalized(QString::NormalizationForm_KD);
+
+    QString normalized;
+    normalized.reserve(decomposed.size());
+    for (const QChar c : decomposed) {
+        if (c.category() != QChar::Mark_NonSpacing) {
+            normalized.append(c.toCaseFolded());
+        }
+    }
+
+    return normalized;
+}
@@ -8,6 +8,8 @@
 
 #include <Plasma/DataEngine>
 
+#include <QStringList>
+
 #include "ion_export.h"
 
 /**
@@ -239,3 +241,44 @@ private:
     class Private;
     Private *const d;
 };
+
+/**
+ * Searchable list of the places an ion knows about, for the validation of locations.
+ *
+ * Places are matched case and diacritics insensitive anywhere in their name. The
+ * n-grams of the normalized names are indexed, so a search only looks at the
+ * places that contain all n-grams of the query instead of at all of them.
+ */
+class ION_EXPORT PlaceIndex
+{
+public:
+    PlaceIndex();
+    ~PlaceIndex();
+
+    void clear();
+
+    /**
+     * Adds a place, by the name it is shown and validated with
+     */
+    void insert(const QString &place);
+
+    int count() const;
+
+    /**
+     * Returns the places containing @p query, best matches first:
+     * the exact name, then names starting with it, then names with a word starting with it,
+     * each alphabetically.
+     */
+    QStringList search(const QString &query) const;
+
+    /**
+     * Case folds @p text and strips its diacritics
+     */
+    static QString normalize(const QString &text);
+
+private:
+    Q_DISABLE_COPY(PlaceIndex)
+
+    class Private;
+    Private *const d;
+};
@@ -0,0 +1,303 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "ionfetchjob.h"
+
+#include "iondebug.h"
+
+#include <KIO/TransferJob>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+const quint32 s_cacheVersion = 1;
+
+// Every URL fetched gets an entry, place searches included, which are rarely asked for again
+const qint64 s_maxCacheAge = 7 * 24 * 60 * 60; // seconds
+const qint64 s_maxCacheSize = 16 * 1024 * 1024; // bytes
+const qint64 s_pruneInterval = 60 * 60; // seconds
+
+QString cacheDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/plasma_engine_weather/http");
+}
+
+QString recordDir()
+{
+    return QFile::decodeName(qgetenv("PLASMA_WEATHER_RECORD_DIR"));
+}
+
+QString replayDir()
+{
+    return QFile::decodeName(qgetenv("PLASMA_WEATHER_REPLAY_DIR"));
+}
+
+bool readCache(const QUrl &url, QByteArray &body)
+{
+    QFile file(cacheDir() + QLatin1Char('/') + IonFetchJob::fileName(url));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 version = 0;
+    QUrl cachedUrl;
+    QDateTime expiry;
+    stream >> version >> cachedUrl >> expiry >> body;
+
+    if (stream.status() != QDataStream::Ok || version != s_cacheVersion || cachedUrl != url || expiry <= QDateTime::currentDateTimeUtc()) {
+        // Of no use anymore
+        file.remove();
+        return false;
+    }
+
+    return true;
+}
+
+// Drops the entries that are too old, then the oldest ones until the cache fits
+void pruneCache()
+{
+    static QDateTime s_lastPruned;
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (s_lastPruned.isValid() && s_lastPruned.secsTo(now) < s_pruneInterval) {
+        return;
+    }
+    s_lastPruned = now;
+
+    // Newest first
+    const QFileInfoList entries = QDir(cacheDir()).entryInfoList(QDir::Files, QDir::Time);
+
+    qint64 size = 0;
+    for (const QFileInfo &entry : entries) {
+        size += entry.size();
+        if (size > s_maxCacheSize || entry.lastModified().secsTo(now) > s_maxCacheAge) {
+            QFile::remove(entry.filePath());
+        }
+    }
+}
+
+void writeCache(const QUrl &url, const QDateTime &expiry, const QByteArray &body)
+{
+    QDir().mkpath(cacheDir());
+
+    QSaveFile file(cacheDir() + QLatin1Char('/') + IonFetchJob::fileName(url));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << s_cacheVersion << url << expiry << body;
+
+    if (file.commit()) {
+        pruneCache();
+    }
+}
+
+void writeFixture(const QString &dir, const QUrl &url, const QByteArray &body)
+{
+    QDir().mkpath(dir);
+
+    QSaveFile file(dir + QLatin1Char('/') + IonFetchJob::fileName(url));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(body);
+    file.commit();
+
+    // Which fixture is which, for whoever edits them, one line per fixture
+    const QByteArray name = IonFetchJob::fileName(url).toLatin1();
+    QByteArray entries;
+    QFile oldIndex(dir + QStringLiteral("/index.txt"));
+    if (oldIndex.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> lines = oldIndex.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (!line.isEmpty() && !line.startsWith(name + ' ')) {
+                entries += line + '\n';
+            }
+        }
+        oldIndex.close();
+    }
+    entries += name + ' ' + url.toEncoded() + '\n';
+
+    QSaveFile index(dir + QStringLiteral("/index.txt"));
+    if (index.open(QIODevice::WriteOnly)) {
+        index.write(entries);
+        index.commit();
+    }
+}
+}
+
+IonFetchJob::IonFetchJob(const QUrl &url, KIO::LoadType reload)
+    : m_url(url)
+    , m_reload(reload)
+{
+}
+
+IonFetchJob::~IonFetchJob() = default;
+
+IonFetchJob *IonFetchJob::get(const QUrl &url, KIO::LoadType reload)
+{
+    auto *job = new IonFetchJob(url, reload);
+    // The caller connects to the job first
+    QMetaObject::invokeMethod(job, &IonFetchJob::start, Qt::QueuedConnection);
+    return job;
+}
+
+QUrl IonFetchJob::url() const
+{
+    return m_url;
+}
+
+void IonFetchJob::addMetaData(const QString &key, const QString &value)
+{
+    m_metaData.insert(key, value);
+}
+
+QString IonFetchJob::fileName(const QUrl &url)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1).toHex());
+}
+
+QDateTime IonFetchJob::expiry(const QString &headers, const QDateTime &now)
+{
+    qint64 maxAge = -1;
+    qint64 age = 0;
+    QDateTime expires;
+
+    const QStringList lines = headers.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+    for (const QString &line : lines) {
+        const int colon = line.indexOf(QLatin1Char(':'));
+        if (colon < 0) {
+            continue;
+        }
+
+        const QString name = line.left(colon).trimmed();
+        const QString value = line.mid(colon + 1).trimmed();
+
+        if (name.compare(QLatin1String("Cache-Control"), Qt::CaseInsensitive) == 0) {
+            const QStringList directives = value.split(QLatin1Char(','));
+            for (const QString &directive : directives) {
+                const QString trimmed = directive.trimmed().toLower();
+                if (trimmed == QLatin1String("no-store") || trimmed == QLatin1String("no-cache")) {
+                    return QDateTime();
+                }
+                if (trimmed.startsWith(QLatin1String("max-age="))) {
+                    maxAge = trimmed.mid(8).toLongLong();
+                }
+            }
+        } else if (name.compare(QLatin1String("Expires"), Qt::CaseInsensitive) == 0) {
+            expires = QDateTime::fromString(value, Qt::RFC2822Date);
+        } else if (name.compare(QLatin1String("Age"), Qt::CaseInsensitive) == 0) {
+            age = value.toLongLong();
+        }
+    }
+
+    // max-age takes precedence, and counts from when a proxy got the response
+    if (maxAge >= 0) {
+        return maxAge > age ? now.addSecs(maxAge - age) : QDateTime();
+    }
+
+    if (expires.isValid() && expires > now) {
+        return expires;
+    }
+
+    return QDateTime();
+}
+
+void IonFetchJob::start()
+{
+    const QString replay = replayDir();
+    if (!replay.isEmpty()) {
+        QFile fixture(replay + QLatin1Char('/') + fileName(m_url));
+        if (!fixture.open(QIODevice::ReadOnly)) {
+            qCWarning(IONENGINE) << "No fixture for" << m_url << "in" << replay;
+            setError(KIO::ERR_DOES_NOT_EXIST);
+            setErrorText(m_url.toDisplayString());
+            emitResult();
+            return;
+        }
+
+        deliver(fixture.readAll());
+        return;
+    }
+
+    // Recording is about what the service sends right now
+    const bool recording = !recordDir().isEmpty();
+    QByteArray body;
+    if (!recording && readCache(m_url, body)) {
+        qCDebug(IONENGINE) << "Using cached response for" << m_url;
+        deliver(body);
+        return;
+    }
+
+    m_transferJob = KIO::get(m_url, recording ? KIO::Reload : m_reload, KIO::HideProgressInfo);
+    m_transferJob->addMetaData(m_metaData);
+    m_transferJob->addMetaData(QStringLiteral("PropagateHttpHeader"), QStringLiteral("true"));
+
+    connect(m_transferJob.data(), &KIO::TransferJob::data, this, [this](KIO::Job *, const QByteArray &data) {
+        if (data.isEmpty()) {
+            return;
+        }
+        m_body += data;
+        Q_EMIT this->data(this, data);
+    });
+    connect(m_transferJob.data(), &KJob::result, this, [this](KJob *job) {
+        transferFinished(static_cast<KIO::TransferJob *>(job));
+    });
+}
+
+void IonFetchJob::deliver(const QByteArray &body)
+{
+    if (!body.isEmpty()) {
+        Q_EMIT data(this, body);
+    }
+    emitResult();
+}
+
+void IonFetchJob::transferFinished(KIO::TransferJob *job)
+{
+    if (job->error()) {
+        setError(job->error());
+        setErrorText(job->errorText());
+        emitResult();
+        return;
+    }
+
+    // Error pages are delivered as data too, those are not worth keeping
+    if (job->queryMetaData(QStringLiteral("responsecode")) == QLatin1String("200")) {
+        const QString record = recordDir();
+        if (!record.isEmpty()) {
+            writeFixture(record, m_url, m_body);
+        }
+
+        const QDateTime expiry = IonFetchJob::expiry(job->queryMetaData(QStringLiteral("HTTP-Headers")), QDateTime::currentDateTimeUtc());
+        if (expiry.isValid()) {
+            writeCache(m_url, expiry, m_body);
+        }
+    }
+
+    m_body.clear();
+    emitResult();
+}
+
+bool IonFetchJob::doKill()
+{
+    if (m_transferJob) {
+        return m_transferJob->kill();
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <KIO/Job>
+#include <KJob>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QMap>
+#include <QPointer>
+#include <QUrl>
+
+#include "ion_export.h"
+
+namespace KIO
+{
+class TransferJob;
+}
+
+/**
+ * Fetches the data of a weather service, to be used by ions instead of KIO::get.
+ *
+ * Responses are kept in a cache on disk for as long as the service allows it
+ * with its Cache-Control or Expires headers, so that restarting Plasma does not
+ * fetch the forecasts again while they are still valid. Expired entries are removed
+ * when they are read, and the cache is pruned by age and total size.
+ *
+ * For testing and benchmarking the parsers offline, responses can be recorded to
+ * and replayed from a directory, given by the PLASMA_WEATHER_RECORD_DIR and
+ * PLASMA_WEATHER_REPLAY_DIR environment variables. Fixtures are named after the
+ * hex encoded SHA-1 of the URL and contain the raw response body. When replaying,
+ * the network and the cache are never used and a missing fixture is an error.
+ */
+class ION_EXPORT IonFetchJob : public KJob
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Creates a job fetching @p url, which starts on its own like the KIO jobs
+     *
+     * @param reload whether the KIO HTTP cache may answer, when nothing is in our own
+     * cache; large catalogs the service sends no expiry for want KIO::NoReload
+     */
+    static IonFetchJob *get(const QUrl &url, KIO::LoadType reload = KIO::Reload);
+
+    ~IonFetchJob() override;
+
+    void start() override;
+
+    QUrl url() const;
+
+    /**
+     * Passed on to the KIO job, when the data comes from the network
+     */
+    void addMetaData(const QString &key, const QString &value);
+
+    /**
+     * The name of the cache entry or fixture of @p url
+     */
+    static QString fileName(const QUrl &url);
+
+    /**
+     * Until when a response with the given HTTP headers may be used, invalid if not at all
+     */
+    static QDateTime expiry(const QString &headers, const QDateTime &now);
+
+Q_SIGNALS:
+    /**
+     * Data arrived, in one or several chunks
+     */
+    void data(KJob *job, const QByteArray &data);
+
+protected:
+    bool doKill() override;
+
+private:
+    IonFetchJob(const QUrl &url, KIO::LoadType reload);
+
+    void deliver(const QByteArray &body);
+    void transferFinished(KIO::TransferJob *job);
+
+    QUrl m_url;
+    KIO::LoadType m_reload;
+    QMap<QString, QString> m_metaData;
+    QByteArray m_body;
+    QPointer<KIO::TransferJob> m_transferJob;
+};
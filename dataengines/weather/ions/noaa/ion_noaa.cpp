@@ -9,8 +9,8 @@
 #include "ion_noaa.h"
 
 #include "ion_noaadebug.h"
+#include "../ionfetchjob.h"
 
-#include <KIO/Job>
 #include <KLocalizedString>
 #include <KUnitConversion/Converter>
 
@@ -92,30 +92,27 @@ NOAAIon::~NOAAIon()
 QStringList NOAAIon::validate(const QString &source) const
 {
     QStringList placeList;
-    QString station;
-    QString sourceNormalized = source.toUpper();
 
-    QHash<QString, NOAAIon::XMLMapInfo>::const_iterator it = m_places.constBegin();
-    // If the source name might look like a station ID, check these too and return the name
-    bool checkState = source.count() == 2;
-
-    while (it != m_places.constEnd()) {
-        if (checkState) {
-            if (it.value().stateName == source) {
-                placeList.append(QStringLiteral("place|").append(it.key()));
-            }
-        } else if (it.key().toUpper().contains(sourceNormalized)) {
-            placeList.append(QStringLiteral("place|").append(it.key()));
-        } else if (it.value().stationID == sourceNormalized) {
-            station = QStringLiteral("place|").append(it.key());
+    // If the source name might look like a state, list the places in it
+    if (source.count() == 2) {
+        QStringList places = m_placesByState.values(source);
+        places.sort();
+        for (const QString &place : qAsConst(places)) {
+            placeList.append(QStringLiteral("place|").append(place));
         }
+        return placeList;
+    }
 
-        ++it;
+    const QStringList places = m_placeIndex.search(source);
+    placeList.reserve(places.size() + 1);
+    for (const QString &place : places) {
+        placeList.append(QStringLiteral("place|").append(place));
     }
 
-    placeList.sort();
-    if (!station.isEmpty()) {
-        placeList.prepend(station);
+    // If the source name might look like a station ID, check these too and return the name
+    const QString station = m_placesByStationId.value(source.toUpper());
+    if (!station.isEmpty() && !places.contains(station)) {
+        placeList.prepend(QStringLiteral("place|").append(station));
     }
 
     return placeList;
@@ -165,9 +162,9 @@ void NOAAIon::getXMLSetup() const
 {
     const QUrl url(QStringLiteral("https://www.weather.gov/data/current_obs/index.xml"));
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::NoReload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url, KIO::NoReload);
 
-    connect(getJob, &KIO::TransferJob::data, this, &NOAAIon::setup_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &NOAAIon::setup_slotDataArrived);
     connect(getJob, &KJob::result, this, &NOAAIon::setup_slotJobFinished);
 }
 
@@ -191,15 +188,15 @@ void NOAAIon::getXMLData(const QString &source)
         return;
     }
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
     m_jobXml.insert(getJob, new QXmlStreamReader);
     m_jobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &NOAAIon::slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &NOAAIon::slotDataArrived);
     connect(getJob, &KJob::result, this, &NOAAIon::slotJobFinished);
 }
 
-void NOAAIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void NOAAIon::setup_slotDataArrived(KJob *job, const QByteArray &data)
 {
     Q_UNUSED(job)
 
@@ -211,7 +208,7 @@ void NOAAIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
     m_xmlSetup.addData(data);
 }
 
-void NOAAIon::slotDataArrived(KIO::Job *job, const QByteArray &data)
+void NOAAIon::slotDataArrived(KJob *job, const QByteArray &data)
 {
     if (data.isEmpty() || !m_jobXml.contains(job)) {
         return;
@@ -299,6 +296,9 @@ void NOAAIon::parseStationID()
 
                 QString tmp = stationName + QLatin1String(", ") + state; // Build the key name.
                 m_places[tmp] = info;
+                m_placeIndex.insert(tmp);
+                m_placesByState.insert(state, tmp);
+                m_placesByStationId.insert(stationID, tmp);
             }
             break;
         }
@@ -770,15 +770,15 @@ void NOAAIon::getForecast(const QString &source)
                                  "ndfdBrowserClientByDay.php?lat=")
                    + QString::number(lat) + QLatin1String("&lon=") + QString::number(lon) + QLatin1String("&format=24+hourly&numDays=7"));
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
     m_jobXml.insert(getJob, new QXmlStreamReader);
     m_jobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &NOAAIon::forecast_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &NOAAIon::forecast_slotDataArrived);
     connect(getJob, &KJob::result, this, &NOAAIon::forecast_slotJobFinished);
 }
 
-void NOAAIon::forecast_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void NOAAIon::forecast_slotDataArrived(KJob *job, const QByteArray &data)
 {
     if (data.isEmpty() || !m_jobXml.contains(job)) {
         return;
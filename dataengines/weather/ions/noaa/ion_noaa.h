@@ -16,10 +16,6 @@
 #include <QXmlStreamReader>
 
 class KJob;
-namespace KIO
-{
-class Job;
-} // namespace KIO
 
 class WeatherData
 {
@@ -90,13 +86,13 @@ protected: // IonInterface API
     void reset() override;
 
 private Q_SLOTS:
-    void setup_slotDataArrived(KIO::Job *, const QByteArray &);
+    void setup_slotDataArrived(KJob *, const QByteArray &);
     void setup_slotJobFinished(KJob *);
 
-    void slotDataArrived(KIO::Job *, const QByteArray &);
+    void slotDataArrived(KJob *, const QByteArray &);
     void slotJobFinished(KJob *);
 
-    void forecast_slotDataArrived(KIO::Job *, const QByteArray &);
+    void forecast_slotDataArrived(KJob *, const QByteArray &);
     void forecast_slotJobFinished(KJob *);
 
 private:
@@ -149,6 +145,9 @@ private:
 
     // Key dicts
     QHash<QString, NOAAIon::XMLMapInfo> m_places;
+    PlaceIndex m_placeIndex;
+    QMultiHash<QString, QString> m_placesByState;
+    QHash<QString, QString> m_placesByStationId;
 
     // Weather information
     QHash<QString, WeatherData> m_weatherData;
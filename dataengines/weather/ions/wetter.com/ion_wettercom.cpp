@@ -16,8 +16,9 @@
 #include "ion_wettercom.h"
 
 #include "ion_wettercomdebug.h"
+#include "../ionfetchjob.h"
 
-#include <KIO/Job>
+#include <KIO/Global>
 #include <KLocalizedString>
 #include <KUnitConversion/Converter>
 
@@ -298,16 +299,16 @@ void WetterComIon::findPlace(const QString &place, const QString &source)
 
     const QUrl url(QStringLiteral(SEARCH_URL).arg(place, encodedKey));
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
     getJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none")); // Disable displaying cookies
     m_searchJobXml.insert(getJob, new QXmlStreamReader);
     m_searchJobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &WetterComIon::setup_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &WetterComIon::setup_slotDataArrived);
     connect(getJob, &KJob::result, this, &WetterComIon::setup_slotJobFinished);
 }
 
-void WetterComIon::setup_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void WetterComIon::setup_slotDataArrived(KJob *job, const QByteArray &data)
 {
     QByteArray local = data;
 
@@ -451,16 +452,16 @@ void WetterComIon::fetchForecast(const QString &source)
 
     const QUrl url(QStringLiteral(FORECAST_URL).arg(m_place[source].placeCode, encodedKey));
 
-    KIO::TransferJob *getJob = KIO::get(url, KIO::Reload, KIO::HideProgressInfo);
+    IonFetchJob *getJob = IonFetchJob::get(url);
     getJob->addMetaData(QStringLiteral("cookies"), QStringLiteral("none"));
     m_forecastJobXml.insert(getJob, new QXmlStreamReader);
     m_forecastJobList.insert(getJob, source);
 
-    connect(getJob, &KIO::TransferJob::data, this, &WetterComIon::forecast_slotDataArrived);
+    connect(getJob, &IonFetchJob::data, this, &WetterComIon::forecast_slotDataArrived);
     connect(getJob, &KJob::result, this, &WetterComIon::forecast_slotJobFinished);
 }
 
-void WetterComIon::forecast_slotDataArrived(KIO::Job *job, const QByteArray &data)
+void WetterComIon::forecast_slotDataArrived(KJob *job, const QByteArray &data)
 {
     QByteArray local = data;
 
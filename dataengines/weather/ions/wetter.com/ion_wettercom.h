@@ -23,11 +23,6 @@
 #define MIN_POLL_INTERVAL 3600000L // 1 h
 
 class KJob;
-namespace KIO
-{
-class Job;
-class TransferJob;
-}
 class QXmlStreamReader;
 
 class WeatherData
@@ -100,10 +95,10 @@ protected: // IonInterface API
     void reset() override;
 
 private Q_SLOTS:
-    void setup_slotDataArrived(KIO::Job *, const QByteArray &);
+    void setup_slotDataArrived(KJob *, const QByteArray &);
     void setup_slotJobFinished(KJob *);
 
-    void forecast_slotDataArrived(KIO::Job *, const QByteArray &);
+    void forecast_slotDataArrived(KJob *, const QByteArray &);
     void forecast_slotJobFinished(KJob *);
 
 private:
@@ -0,0 +1,154 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QSignalSpy>
+#include <QtTest>
+
+#include "../freespacemonitor.h"
+
+using namespace std::chrono_literals;
+
+static constexpr quint64 s_mib = 1024 * 1024;
+static constexpr quint64 s_threshold = 200 * s_mib;
+
+// Filesystems whose usage and clock the test controls
+class FakeBackend : public FreeSpaceMonitor::Backend
+{
+public:
+    bool usage(const QString &path, FreeSpaceMonitor::Usage &usage) override
+    {
+        auto it = filesystems.constFind(path);
+        if (it == filesystems.constEnd()) {
+            return false;
+        }
+        usage = *it;
+        return true;
+    }
+
+    std::chrono::steady_clock::time_point now() const override
+    {
+        return clock;
+    }
+
+    QHash<QString, FreeSpaceMonitor::Usage> filesystems;
+    std::chrono::steady_clock::time_point clock;
+};
+
+class FreeSpaceMonitorTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testNextInterval_data();
+    void testNextInterval();
+    void testSweep();
+    void testAdaptsToFillRate();
+    void testUnmounted();
+};
+
+void FreeSpaceMonitorTest::testNextInterval_data()
+{
+    QTest::addColumn<quint64>("available");
+    QTest::addColumn<double>("fillRate");
+    QTest::addColumn<qint64>("expected");
+
+    QTest::newRow("plenty, stable") << 100000 * s_mib << 0.0 << qint64(std::chrono::milliseconds(10min).count());
+    QTest::newRow("plenty, freeing") << 100000 * s_mib << -1000.0 << qint64(std::chrono::milliseconds(10min).count());
+    QTest::newRow("plenty, filling slowly") << 100000 * s_mib << 1000.0 << qint64(std::chrono::milliseconds(10min).count());
+    // 800 MiB to go at 1 MiB/s, a quarter of that
+    QTest::newRow("filling fast") << 1000 * s_mib << double(s_mib) << qint64(std::chrono::milliseconds(200s).count());
+    QTest::newRow("filling very fast") << 1000 * s_mib << 1000.0 * s_mib << qint64(std::chrono::milliseconds(5s).count());
+    QTest::newRow("close to threshold") << 300 * s_mib << 0.0 << qint64(std::chrono::milliseconds(1min).count());
+    QTest::newRow("below threshold") << 100 * s_mib << 0.0 << qint64(std::chrono::milliseconds(1min).count());
+}
+
+void FreeSpaceMonitorTest::testNextInterval()
+{
+    QFETCH(quint64, available);
+    QFETCH(double, fillRate);
+    QFETCH(qint64, expected);
+
+    QCOMPARE(FreeSpaceMonitor::nextInterval(available, s_threshold, fillRate).count(), expected);
+}
+
+void FreeSpaceMonitorTest::testSweep()
+{
+    auto backend = std::make_unique<FakeBackend>();
+    backend->filesystems.insert(QStringLiteral("/"), {10000 * s_mib, 5000 * s_mib});
+    backend->filesystems.insert(QStringLiteral("/home"), {10000 * s_mib, 100 * s_mib});
+
+    FreeSpaceMonitor monitor(std::move(backend));
+    monitor.setThreshold(s_threshold);
+    monitor.addPath(QStringLiteral("/"));
+    monitor.addPath(QStringLiteral("/home"));
+
+    QSignalSpy spy(&monitor, &FreeSpaceMonitor::sampled);
+    monitor.sweep();
+
+    // Both in one sweep
+    QCOMPARE(spy.count(), 2);
+    QHash<QString, quint64> available;
+    for (const QList<QVariant> &arguments : qAsConst(spy)) {
+        available.insert(arguments.at(0).toString(), arguments.at(2).toULongLong());
+    }
+    QCOMPARE(available.value(QStringLiteral("/")), 5000 * s_mib);
+    QCOMPARE(available.value(QStringLiteral("/home")), 100 * s_mib);
+
+    // The filesystem running out of space sets the pace
+    QVERIFY(monitor.interval() <= 1min);
+}
+
+void FreeSpaceMonitorTest::testAdaptsToFillRate()
+{
+    auto backend = std::make_unique<FakeBackend>();
+    FakeBackend *fake = backend.get();
+    fake->filesystems.insert(QStringLiteral("/"), {100000 * s_mib, 50000 * s_mib});
+
+    FreeSpaceMonitor monitor(std::move(backend));
+    monitor.setThreshold(s_threshold);
+    monitor.addPath(QStringLiteral("/"));
+
+    monitor.sweep();
+    QVERIFY(monitor.interval() > 5min);
+
+    // Stable, nothing changes
+    fake->clock += 10min;
+    monitor.sweep();
+    QVERIFY(monitor.interval() > 5min);
+
+    // Something writes 10 GiB per minute
+    for (int i = 0; i < 4; ++i) {
+        fake->clock += 1min;
+        fake->filesystems[QStringLiteral("/")].available -= 10 * 1024 * s_mib;
+        monitor.sweep();
+    }
+    QVERIFY(monitor.interval() < 1min);
+}
+
+void FreeSpaceMonitorTest::testUnmounted()
+{
+    auto backend = std::make_unique<FakeBackend>();
+    FakeBackend *fake = backend.get();
+
+    FreeSpaceMonitor monitor(std::move(backend));
+    monitor.setThreshold(s_threshold);
+    monitor.addPath(QStringLiteral("/media/usb"));
+
+    QSignalSpy spy(&monitor, &FreeSpaceMonitor::sampled);
+    monitor.sweep();
+    QCOMPARE(spy.count(), 0);
+
+    fake->filesystems.insert(QStringLiteral("/media/usb"), {1000 * s_mib, 100 * s_mib});
+    monitor.mountsChanged();
+    QVERIFY(monitor.interval() <= 1s);
+
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+}
+
+QTEST_GUILESS_MAIN(FreeSpaceMonitorTest)
+
+#include "freespacemonitortest.moc"
@@ -0,0 +1,185 @@
+/*
+    SPDX-FileCopyrightText: 2006 Lukas Tinkl <ltinkl@suse.cz>
+    SPDX-FileCopyrightText: 2008 Lubos Lunak <l.lunak@suse.cz>
+    SPDX-FileCopyrightText: 2009 Ivo Anjo <knuckles@gmail.com>
+    SPDX-FileCopyrightText: 2020 Kai Uwe Broulik <kde@broulik.de>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "freespacemonitor.h"
+
+#include <QSocketNotifier>
+
+#include <sys/statvfs.h>
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Give the session some time to settle before the first sweep
+constexpr auto s_initialDelay = 1min;
+// Coalesces the mount changes of e.g. plugging in a disk with several partitions
+constexpr auto s_mountChangeDelay = 1s;
+
+constexpr auto s_minInterval = 5s;
+constexpr auto s_maxInterval = 10min;
+// Below the threshold or close to it, keep what the warning says up to date
+constexpr auto s_lowSpaceInterval = 1min;
+
+// Weight of the latest sample in the fill rate, smoothing out bursts
+constexpr double s_fillRateSmoothing = 0.5;
+
+class StatvfsBackend : public FreeSpaceMonitor::Backend
+{
+public:
+    bool usage(const QString &path, FreeSpaceMonitor::Usage &usage) override
+    {
+        struct statvfs buf;
+        if (statvfs(QFile::encodeName(path).constData(), &buf) != 0) {
+            return false;
+        }
+
+        usage.size = quint64(buf.f_blocks) * buf.f_frsize;
+        usage.available = quint64(buf.f_bavail) * buf.f_frsize;
+        return true;
+    }
+};
+}
+
+FreeSpaceMonitor::Backend::~Backend() = default;
+
+std::chrono::steady_clock::time_point FreeSpaceMonitor::Backend::now() const
+{
+    return std::chrono::steady_clock::now();
+}
+
+FreeSpaceMonitor::FreeSpaceMonitor(std::unique_ptr<Backend> backend, QObject *parent)
+    : QObject(parent)
+    , m_backend(backend ? std::move(backend) : std::make_unique<StatvfsBackend>())
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &FreeSpaceMonitor::sweep);
+
+    watchMounts();
+}
+
+FreeSpaceMonitor::~FreeSpaceMonitor() = default;
+
+void FreeSpaceMonitor::addPath(const QString &path)
+{
+    if (m_filesystems.contains(path)) {
+        return;
+    }
+
+    m_filesystems.insert(path, Filesystem());
+
+    if (!m_timer.isActive()) {
+        m_timer.start(s_initialDelay);
+    }
+}
+
+void FreeSpaceMonitor::setThreshold(quint64 threshold)
+{
+    m_threshold = threshold;
+}
+
+std::chrono::milliseconds FreeSpaceMonitor::interval() const
+{
+    return std::chrono::milliseconds(m_timer.remainingTime());
+}
+
+std::chrono::milliseconds FreeSpaceMonitor::nextInterval(quint64 available, quint64 threshold, double fillRate)
+{
+    if (available <= threshold) {
+        return s_lowSpaceInterval;
+    }
+
+    std::chrono::milliseconds interval = s_maxInterval;
+
+    // Look again well before it could cross the threshold at the current rate
+    if (fillRate > 0) {
+        const double secondsToThreshold = (available - threshold) / fillRate;
+        const auto quarter = std::chrono::milliseconds(qint64(std::min(secondsToThreshold * 1000 / 4, double(s_maxInterval.count()))));
+        interval = std::clamp<std::chrono::milliseconds>(quarter, s_minInterval, s_maxInterval);
+    }
+
+    // Less than the threshold again to go, small writes may be enough
+    if (available - threshold < threshold) {
+        interval = std::min<std::chrono::milliseconds>(interval, s_lowSpaceInterval);
+    }
+
+    return interval;
+}
+
+void FreeSpaceMonitor::sweep()
+{
+    const auto now = m_backend->now();
+
+    std::chrono::milliseconds interval = s_maxInterval;
+
+    for (auto it = m_filesystems.begin(); it != m_filesystems.end(); ++it) {
+        Filesystem &filesystem = *it;
+
+        Usage usage;
+        if (!m_backend->usage(it.key(), usage) || usage.size == 0) {
+            // e.g. not mounted right now, a mount event will bring it back
+            filesystem.sampled = false;
+            continue;
+        }
+
+        if (filesystem.sampled) {
+            const double seconds = std::chrono::duration<double>(now - filesystem.sampledAt).count();
+            if (seconds > 0) {
+                const double rate = (double(filesystem.usage.available) - double(usage.available)) / seconds;
+                filesystem.fillRate = s_fillRateSmoothing * rate + (1 - s_fillRateSmoothing) * filesystem.fillRate;
+            }
+        } else {
+            filesystem.fillRate = 0;
+        }
+
+        filesystem.usage = usage;
+        filesystem.sampledAt = now;
+        filesystem.sampled = true;
+
+        interval = std::min(interval, nextInterval(usage.available, m_threshold, filesystem.fillRate));
+
+        Q_EMIT sampled(it.key(), usage.size, usage.available);
+    }
+
+    m_timer.start(interval);
+}
+
+void FreeSpaceMonitor::mountsChanged()
+{
+    // What is mounted where changed, the fill rate measured so far is meaningless
+    for (Filesystem &filesystem : m_filesystems) {
+        filesystem.sampled = false;
+    }
+
+    if (!m_filesystems.isEmpty()) {
+        m_timer.start(s_mountChangeDelay);
+    }
+}
+
+void FreeSpaceMonitor::watchMounts()
+{
+#ifdef Q_OS_LINUX
+    // The kernel flags the mount table as exceptional whenever something is (un)mounted
+    m_mounts.setFileName(QStringLiteral("/proc/self/mountinfo"));
+    if (!m_mounts.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    auto *notifier = new QSocketNotifier(m_mounts.handle(), QSocketNotifier::Exception, this);
+    connect(notifier, &QSocketNotifier::activated, this, [this] {
+        // Reading it again acknowledges the change
+        m_mounts.seek(0);
+        m_mounts.readAll();
+        mountsChanged();
+    });
+#endif
+}
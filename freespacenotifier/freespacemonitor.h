@@ -0,0 +1,97 @@
+/*
+    SPDX-FileCopyrightText: 2006 Lukas Tinkl <ltinkl@suse.cz>
+    SPDX-FileCopyrightText: 2008 Lubos Lunak <l.lunak@suse.cz>
+    SPDX-FileCopyrightText: 2009 Ivo Anjo <knuckles@gmail.com>
+    SPDX-FileCopyrightText: 2020 Kai Uwe Broulik <kde@broulik.de>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+#include <memory>
+
+/**
+ * Samples the free space of all watched filesystems in one sweep.
+ *
+ * The time until the next sweep adapts to how close the filesystems are to the
+ * threshold and how fast they fill up: rarely when there is plenty of stable free
+ * space, quickly when it is about to run out. Mounting or unmounting a filesystem
+ * triggers a sweep right away.
+ */
+class FreeSpaceMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Usage {
+        quint64 size = 0;
+        quint64 available = 0;
+    };
+
+    /**
+     * Where the usage of a filesystem comes from, statvfs() unless testing
+     */
+    class Backend
+    {
+    public:
+        virtual ~Backend();
+
+        virtual bool usage(const QString &path, Usage &usage) = 0;
+        virtual std::chrono::steady_clock::time_point now() const;
+    };
+
+    explicit FreeSpaceMonitor(std::unique_ptr<Backend> backend = nullptr, QObject *parent = nullptr);
+    ~FreeSpaceMonitor() override;
+
+    void addPath(const QString &path);
+
+    /**
+     * The free space in bytes below which a filesystem is considered running out of space
+     */
+    void setThreshold(quint64 threshold);
+
+    /**
+     * Time until the next sweep
+     */
+    std::chrono::milliseconds interval() const;
+
+    /**
+     * How long to wait before looking at a filesystem again, given its free space in bytes
+     * and how many bytes per second it currently loses
+     */
+    static std::chrono::milliseconds nextInterval(quint64 available, quint64 threshold, double fillRate);
+
+public Q_SLOTS:
+    void sweep();
+    void mountsChanged();
+
+Q_SIGNALS:
+    void sampled(const QString &path, quint64 size, quint64 available);
+
+private:
+    struct Filesystem {
+        Usage usage;
+        std::chrono::steady_clock::time_point sampledAt;
+        bool sampled = false;
+        // bytes per second, positive when filling up
+        double fillRate = 0;
+    };
+
+    void watchMounts();
+
+    std::unique_ptr<Backend> m_backend;
+    QHash<QString, Filesystem> m_filesystems;
+    quint64 m_threshold = 0;
+
+    QTimer m_timer;
+    QFile m_mounts;
+};
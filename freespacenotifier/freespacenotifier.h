@@ -17,19 +17,21 @@
 
 class KNotification;
 
+class FreeSpaceMonitor;
+
 class FreeSpaceNotifier : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit FreeSpaceNotifier(const QString &path, const KLocalizedString &notificationText, QObject *parent = nullptr);
+    explicit FreeSpaceNotifier(const QString &path, const KLocalizedString &notificationText, FreeSpaceMonitor *monitor, QObject *parent = nullptr);
     ~FreeSpaceNotifier() override;
 
 Q_SIGNALS:
     void configureRequested();
 
 private:
-    void checkFreeDiskSpace();
+    void checkFreeDiskSpace(quint64 size, quint64 available);
     void resetLastAvailable();
 
     KService::Ptr filelightService() const;
@@ -39,7 +41,6 @@ private:
     QString m_path;
     KLocalizedString m_notificationText;
 
-    QTimer m_timer;
     QTimer *m_lastAvailTimer = nullptr;
     QPointer<KNotification> m_notification;
     qint64 m_lastAvail = -1; // used to suppress repeated warnings when available space hasn't changed
@@ -14,6 +14,7 @@
 
 #include <QDir>
 
+#include "freespacemonitor.h"
 #include "kded_interface.h"
 
 #include "ui_freespacenotifier_prefs_base.h"
@@ -24,17 +25,21 @@ K_PLUGIN_CLASS_WITH_JSON(FreeSpaceNotifierModule, "freespacenotifier.json")
 
 FreeSpaceNotifierModule::FreeSpaceNotifierModule(QObject *parent, const QList<QVariant> &)
     : KDEDModule(parent)
+    , m_monitor(new FreeSpaceMonitor(nullptr, this))
 {
     // If the module is loaded, notifications are enabled
     FreeSpaceNotifierSettings::setEnableNotification(true);
 
+    updateThreshold();
+
     const QString rootPath = QStringLiteral("/");
     const QString homePath = QDir::homePath();
 
     const auto homeMountPoint = KMountPoint::currentMountPoints().findByPath(homePath);
 
     if ( !homeMountPoint || !homeMountPoint->mountOptions().contains(QLatin1String("ro")) ) {
-        auto *homeNotifier = new FreeSpaceNotifier(homePath, ki18n("Your Home folder is running out of disk space, you have %1 MiB remaining (%2%)."), this);
+        auto *homeNotifier =
+            new FreeSpaceNotifier(homePath, ki18n("Your Home folder is running out of disk space, you have %1 MiB remaining (%2%)."), m_monitor, this);
         connect(homeNotifier, &FreeSpaceNotifier::configureRequested, this, &FreeSpaceNotifierModule::showConfiguration);
     }
 
@@ -43,11 +48,17 @@ FreeSpaceNotifierModule::FreeSpaceNotifierModule(QObject *parent, const QList<QV
                                         ( homeMountPoint->mountPoint() != rootPath &&
                                           ( !(rootMountPoint = KMountPoint::currentMountPoints().findByPath(rootPath)) ||
                                             !rootMountPoint->mountOptions().contains(QLatin1String("ro")) ) ) ) {
-        auto *rootNotifier = new FreeSpaceNotifier(rootPath, ki18n("Your Root partition is running out of disk space, you have %1 MiB remaining (%2%)."), this);
+        auto *rootNotifier =
+            new FreeSpaceNotifier(rootPath, ki18n("Your Root partition is running out of disk space, you have %1 MiB remaining (%2%)."), m_monitor, this);
         connect(rootNotifier, &FreeSpaceNotifier::configureRequested, this, &FreeSpaceNotifierModule::showConfiguration);
     }
 }
 
+void FreeSpaceNotifierModule::updateThreshold()
+{
+    m_monitor->setThreshold(quint64(FreeSpaceNotifierSettings::minimumSpace()) * 1024 * 1024);
+}
+
 void FreeSpaceNotifierModule::showConfiguration()
 {
     if (KConfigDialog::showDialog(QStringLiteral("settings"))) {
@@ -62,6 +73,8 @@ void FreeSpaceNotifierModule::showConfiguration()
 
     dialog->addPage(generalSettingsDlg, i18nc("The settings dialog main page name, as in 'general settings'", "General"), QStringLiteral("system-run"));
 
+    connect(dialog, &KConfigDialog::settingsChanged, this, &FreeSpaceNotifierModule::updateThreshold);
+
     connect(dialog, &KConfigDialog::finished, this, [] {
         if (!FreeSpaceNotifierSettings::enableNotification()) {
             // The idea here is to disable ourselves by telling kded to stop autostarting us, and
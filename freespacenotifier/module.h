@@ -13,6 +13,8 @@
 
 #include "freespacenotifier.h"
 
+class FreeSpaceMonitor;
+
 class FreeSpaceNotifierModule : public KDEDModule
 {
     Q_OBJECT
@@ -21,4 +23,7 @@ public:
 
 private:
     void showConfiguration();
+    void updateThreshold();
+
+    FreeSpaceMonitor *m_monitor;
 };
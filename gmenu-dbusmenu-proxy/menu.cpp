@@ -280,53 +280,3 @@ void Menu::onMenuChanged(const GMenuChangeList &changes)
 
     Q_EMIT menusChanged(dirtyMenus);
 }
-
-void Menu::actionsChanged(const QStringList &dirtyActions, const QString &prefix)
-{
-    auto forEachMenuItem = [this](const std::function<bool(int subscription, int section, int index, const QVariantMap &item)> &cb) {
-        for (auto it = m_menus.constBegin(), end = m_menus.constEnd(); it != end; ++it) {
-            const int subscription = it.key();
-
-            for (const auto &menu : it.value()) {
-                const int section = menu.section;
-
-                int count = 0;
-
-                const auto items = menu.items;
-                for (const auto &item : items) {
-                    ++count; // 0 is a menu, entries start at 1
-
-                    if (!cb(subscription, section, count, item)) {
-                        goto loopExit; // hell yeah
-                        break;
-                    }
-                }
-            }
-        }
-
-    loopExit: // loop exit
-        return;
-    };
-
-    // now find in which menus these actions are and Q_EMIT a change accordingly
-    QVector<uint> dirtyItems;
-
-    for (const QString &action : dirtyActions) {
-        const QString prefixedAction = prefix + action;
-
-        forEachMenuItem([&prefixedAction, &dirtyItems](int subscription, int section, int index, const QVariantMap &item) {
-            const QString actionName = Utils::itemActionName(item);
-
-            if (actionName == prefixedAction) {
-                dirtyItems.append(Utils::treeStructureToInt(subscription, section, index));
-                return false; // break
-            }
-
-            return true; // continue
-        });
-    }
-
-    if (!dirtyItems.isEmpty()) {
-        Q_EMIT itemsChanged(dirtyItems);
-    }
-}
@@ -36,9 +36,6 @@ public:
     QVariantMap getItem(int id) const; // bool ok argument?
     QVariantMap getItem(int subscription, int sectionId, int id) const;
 
-public Q_SLOTS:
-    void actionsChanged(const QStringList &dirtyActions, const QString &prefix);
-
 Q_SIGNALS:
     void menuAppeared(); // emitted the first time a menu was successfully loaded
     void menuDisappeared();
@@ -225,18 +225,13 @@ void Window::menuItemsChanged(const QVector<uint> &itemIds)
         return;
     }
 
-    DBusMenuItemList items;
-
+    QVector<int> ids;
+    ids.reserve(itemIds.count());
     for (uint id : itemIds) {
-        const auto newItem = m_currentMenu->getItem(id);
-
-        DBusMenuItem dBusItem{// 0 is menu, items start at 1
-                              static_cast<int>(id),
-                              gMenuToDBusMenuProperties(newItem)};
-        items.append(dBusItem);
+        ids.append(static_cast<int>(id));
     }
 
-    Q_EMIT ItemsPropertiesUpdated(items, {});
+    updateTranslatedItems(ids);
 }
 
 void Window::menuChanged(const QVector<uint> &menuIds)
@@ -245,8 +240,22 @@ void Window::menuChanged(const QVector<uint> &menuIds)
         return;
     }
 
+    if (menuIds.isEmpty()) {
+        return;
+    }
+
+    ++m_revision;
+
     for (uint menu : menuIds) {
-        Q_EMIT LayoutUpdated(3 /*revision*/, menu);
+        int subscription;
+        int section;
+        int index;
+        Utils::intToTreeStructure(menu, subscription, section, index);
+
+        // Items moved around, their ids refer to other items now
+        forgetTranslatedItems(subscription, section);
+
+        Q_EMIT LayoutUpdated(m_revision, menu);
     }
 }
 
@@ -269,57 +278,225 @@ void Window::onMenuSubscribed(uint id)
         }
         m_pendingGetLayouts.remove(id);
     } else {
-        Q_EMIT LayoutUpdated(2 /*revision*/, id);
+        Q_EMIT LayoutUpdated(++m_revision, id);
     }
 }
 
-bool Window::getAction(const QString &name, GMenuAction &action) const
+int Window::internAction(const QString &name)
 {
-    QString lookupName;
-    Actions *actions = getActionsForAction(name, lookupName);
+    if (name.isEmpty()) {
+        return -1;
+    }
+
+    auto it = m_actionIds.constFind(name);
+    if (it != m_actionIds.constEnd()) {
+        return *it;
+    }
 
-    if (!actions) {
+    InternedAction action;
+    if (name.startsWith(s_applicationActionsPrefix)) {
+        action.actions = m_applicationActions;
+        action.lookupName = name.mid(s_applicationActionsPrefix.length());
+    } else if (name.startsWith(s_unityActionsPrefix)) {
+        action.actions = m_unityActions;
+        action.lookupName = name.mid(s_unityActionsPrefix.length());
+    } else if (name.startsWith(s_windowActionsPrefix)) {
+        action.actions = m_windowActions;
+        action.lookupName = name.mid(s_windowActionsPrefix.length());
+    }
+
+    const int actionId = m_internedActions.count();
+    m_internedActions.append(action);
+    m_actionIds.insert(name, actionId);
+
+    return actionId;
+}
+
+bool Window::getAction(int actionId, GMenuAction &action) const
+{
+    if (actionId < 0 || actionId >= m_internedActions.count()) {
         return false;
     }
 
-    return actions->get(lookupName, action);
+    const InternedAction &internedAction = m_internedActions.at(actionId);
+    if (!internedAction.actions) {
+        return false;
+    }
+
+    return internedAction.actions->get(internedAction.lookupName, action);
 }
 
-void Window::triggerAction(const QString &name, const QVariant &target, uint timestamp)
+void Window::triggerAction(int actionId, const QVariant &target, uint timestamp)
 {
-    QString lookupName;
-    Actions *actions = getActionsForAction(name, lookupName);
-    if (!actions) {
+    if (actionId < 0 || actionId >= m_internedActions.count()) {
         return;
     }
 
-    actions->trigger(lookupName, target, timestamp);
+    const InternedAction &internedAction = m_internedActions.at(actionId);
+    if (!internedAction.actions) {
+        return;
+    }
+
+    internedAction.actions->trigger(internedAction.lookupName, target, timestamp);
 }
 
-Actions *Window::getActionsForAction(const QString &name, QString &lookupName) const
+void Window::onActionsChanged(const QStringList &dirty, const QString &prefix)
 {
-    if (name.startsWith(QLatin1String("app."))) {
-        lookupName = name.mid(4);
-        return m_applicationActions;
-    } else if (name.startsWith(QLatin1String("unity."))) {
-        lookupName = name.mid(6);
-        return m_unityActions;
-    } else if (name.startsWith(QLatin1String("win."))) {
-        lookupName = name.mid(4);
-        return m_windowActions;
+    QVector<int> ids;
+
+    for (const QString &action : dirty) {
+        auto it = m_actionIds.constFind(prefix + action);
+        if (it == m_actionIds.constEnd()) {
+            // not used by any item we handed out
+            continue;
+        }
+
+        const QSet<int> items = m_itemsForAction.value(*it);
+        for (int id : items) {
+            ids.append(id);
+        }
     }
 
-    return nullptr;
+    updateTranslatedItems(ids);
 }
 
-void Window::onActionsChanged(const QStringList &dirty, const QString &prefix)
+QVariantMap Window::translatedItem(int id, const QVariantMap &source)
 {
-    if (m_applicationMenu) {
-        m_applicationMenu->actionsChanged(dirty, prefix);
+    auto it = m_translatedItems.constFind(id);
+    if (it != m_translatedItems.constEnd()) {
+        return it->properties;
     }
-    if (m_menuBar) {
-        m_menuBar->actionsChanged(dirty, prefix);
+
+    TranslatedItem item;
+    item.actionId = internAction(Utils::itemActionName(source));
+    item.properties = gMenuToDBusMenuProperties(source, item.actionId);
+
+    if (item.actionId != -1) {
+        m_itemsForAction[item.actionId].insert(id);
+    }
+
+    m_translatedItems.insert(id, item);
+    return item.properties;
+}
+
+// DBusMenuShortcut has no registered comparator, QVariant would never consider two of them equal
+static bool propertyEquals(const QVariant &a, const QVariant &b)
+{
+    if (a.userType() == qMetaTypeId<DBusMenuShortcut>() && b.userType() == a.userType()) {
+        return a.value<DBusMenuShortcut>() == b.value<DBusMenuShortcut>();
+    }
+    return a == b;
+}
+
+void Window::updateTranslatedItems(const QVector<int> &ids)
+{
+    if (!m_currentMenu) {
+        return;
     }
+
+    DBusMenuItemList updatedItems;
+    DBusMenuItemKeysList removedProperties;
+    QSet<int> dirtyMenus;
+
+    for (int id : ids) {
+        auto it = m_translatedItems.find(id);
+        if (it == m_translatedItems.end()) {
+            // clients haven't seen it yet, it is translated once they ask for it
+            continue;
+        }
+
+        const QVariantMap source = m_currentMenu->getItem(id);
+
+        const int actionId = internAction(Utils::itemActionName(source));
+        if (actionId != it->actionId) {
+            if (it->actionId != -1) {
+                m_itemsForAction[it->actionId].remove(id);
+            }
+            if (actionId != -1) {
+                m_itemsForAction[actionId].insert(id);
+            }
+            it->actionId = actionId;
+        }
+
+        const QVariantMap properties = gMenuToDBusMenuProperties(source, actionId);
+
+        // An item becoming or ceasing to be a section changes what the menu contains
+        const bool wasSection = it->properties.value(QStringLiteral("type")) == QLatin1String("separator");
+        if (source.contains(QLatin1String(":section")) != wasSection) {
+            int subscription;
+            int section;
+            int index;
+            Utils::intToTreeStructure(id, subscription, section, index);
+            dirtyMenus.insert(Utils::treeStructureToInt(subscription, section, 0));
+            continue;
+        }
+
+        DBusMenuItem updatedItem{id, {}};
+        for (auto propertyIt = properties.constBegin(); propertyIt != properties.constEnd(); ++propertyIt) {
+            if (!propertyEquals(it->properties.value(propertyIt.key()), propertyIt.value())) {
+                updatedItem.properties.insert(propertyIt.key(), propertyIt.value());
+            }
+        }
+
+        DBusMenuItemKeys removedItemProperties{id, {}};
+        for (auto propertyIt = it->properties.constBegin(); propertyIt != it->properties.constEnd(); ++propertyIt) {
+            if (!properties.contains(propertyIt.key())) {
+                removedItemProperties.properties.append(propertyIt.key());
+            }
+        }
+
+        it->properties = properties;
+
+        if (!updatedItem.properties.isEmpty()) {
+            updatedItems.append(updatedItem);
+        }
+        if (!removedItemProperties.properties.isEmpty()) {
+            removedProperties.append(removedItemProperties);
+        }
+    }
+
+    if (!updatedItems.isEmpty() || !removedProperties.isEmpty()) {
+        Q_EMIT ItemsPropertiesUpdated(updatedItems, removedProperties);
+    }
+
+    if (!dirtyMenus.isEmpty()) {
+        ++m_revision;
+        for (int menu : qAsConst(dirtyMenus)) {
+            int subscription;
+            int section;
+            int index;
+            Utils::intToTreeStructure(menu, subscription, section, index);
+            forgetTranslatedItems(subscription, section);
+
+            Q_EMIT LayoutUpdated(m_revision, menu);
+        }
+    }
+}
+
+void Window::forgetTranslatedItems(int subscription, int section)
+{
+    for (auto it = m_translatedItems.begin(); it != m_translatedItems.end();) {
+        int itemSubscription;
+        int itemSection;
+        int index;
+        Utils::intToTreeStructure(it.key(), itemSubscription, itemSection, index);
+
+        if (itemSubscription != subscription || itemSection != section) {
+            ++it;
+            continue;
+        }
+
+        if (it->actionId != -1) {
+            m_itemsForAction[it->actionId].remove(it.key());
+        }
+        it = m_translatedItems.erase(it);
+    }
+}
+
+void Window::clearTranslatedItems()
+{
+    m_translatedItems.clear();
+    m_itemsForAction.clear();
 }
 
 bool Window::registerDBusObject()
@@ -367,7 +544,8 @@ void Window::updateWindowProperties()
 
     if (m_currentMenu != oldMenu) {
         // update entire menu now
-        Q_EMIT LayoutUpdated(4 /*revision*/, 0);
+        clearTranslatedItems();
+        Q_EMIT LayoutUpdated(++m_revision, 0);
     }
 
     Q_EMIT requestWriteWindowProperties();
@@ -397,7 +575,7 @@ void Window::Event(int id, const QString &eventId, const QDBusVariant &data, uin
         const QString action = item.value(QStringLiteral("action")).toString();
         const QVariant target = item.value(QStringLiteral("target"));
         if (!action.isEmpty()) {
-            triggerAction(action, target, timestamp);
+            triggerAction(internAction(action), target, timestamp);
         }
     }
 }
@@ -470,9 +648,10 @@ uint Window::GetLayout(int parentId, int recursionDepth, const QStringList &prop
 
     const auto itemsToBeAdded = section.items;
     for (const auto &item : itemsToBeAdded) {
+        const int childId = Utils::treeStructureToInt(section.id, sectionId, ++count);
         DBusMenuLayoutItem child{
-            Utils::treeStructureToInt(section.id, sectionId, ++count),
-            gMenuToDBusMenuProperties(item),
+            childId,
+            translatedItem(childId, item),
             {} // children
         };
         dbusItem.children.append(child);
@@ -507,9 +686,10 @@ uint Window::GetLayout(int parentId, int recursionDepth, const QStringList &prop
 
             int aliasedCount = 0;
             for (const auto &aliasedItem : qAsConst(items)) {
+                const int aliasedChildId = Utils::treeStructureToInt(originalSubscription, originalMenu, ++aliasedCount);
                 DBusMenuLayoutItem aliasedChild{
-                    Utils::treeStructureToInt(originalSubscription, originalMenu, ++aliasedCount),
-                    gMenuToDBusMenuProperties(aliasedItem),
+                    aliasedChildId,
+                    translatedItem(aliasedChildId, aliasedItem),
                     {} // children
                 };
                 dbusItem.children.append(aliasedChild);
@@ -517,8 +697,7 @@ uint Window::GetLayout(int parentId, int recursionDepth, const QStringList &prop
         }
     }
 
-    // revision, unused in libdbusmenuqt
-    return 1;
+    return m_revision;
 }
 
 QDBusVariant Window::GetProperty(int id, const QString &property)
@@ -539,7 +718,7 @@ uint Window::version() const
     return 4;
 }
 
-QVariantMap Window::gMenuToDBusMenuProperties(const QVariantMap &source) const
+QVariantMap Window::gMenuToDBusMenuProperties(const QVariantMap &source, int actionId) const
 {
     QVariantMap result;
 
@@ -601,7 +780,7 @@ QVariantMap Window::gMenuToDBusMenuProperties(const QVariantMap &source) const
     // disable the menu entry
     bool actionOk = true;
     if (!actionName.isEmpty()) {
-        actionOk = getAction(actionName, action);
+        actionOk = getAction(actionId, action);
         enabled = actionOk && action.enabled;
     }
 
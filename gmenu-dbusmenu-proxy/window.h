@@ -7,8 +7,10 @@
 #pragma once
 
 #include <QDBusContext>
+#include <QHash>
 #include <QMultiHash>
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QVector>
 #include <QWindow> // for WId
@@ -87,9 +89,21 @@ private:
     bool registerDBusObject();
     void updateWindowProperties();
 
-    bool getAction(const QString &name, GMenuAction &action) const;
-    void triggerAction(const QString &name, const QVariant &target, uint timestamp = 0);
-    Actions *getActionsForAction(const QString &name, QString &lookupName) const;
+    // An action name resolved once to the Actions it belongs to
+    struct InternedAction {
+        Actions *actions = nullptr;
+        QString lookupName;
+    };
+
+    // The DBusMenu properties of an item as clients last got them
+    struct TranslatedItem {
+        QVariantMap properties;
+        int actionId = -1;
+    };
+
+    int internAction(const QString &name);
+    bool getAction(int actionId, GMenuAction &action) const;
+    void triggerAction(int actionId, const QVariant &target, uint timestamp = 0);
 
     void menuChanged(const QVector<uint> &menuIds);
     void menuItemsChanged(const QVector<uint> &itemIds);
@@ -97,7 +111,12 @@ private:
     void onActionsChanged(const QStringList &dirty, const QString &prefix);
     void onMenuSubscribed(uint id);
 
-    QVariantMap gMenuToDBusMenuProperties(const QVariantMap &source) const;
+    QVariantMap translatedItem(int id, const QVariantMap &source);
+    void updateTranslatedItems(const QVector<int> &ids);
+    void forgetTranslatedItems(int subscription, int section);
+    void clearTranslatedItems();
+
+    QVariantMap gMenuToDBusMenuProperties(const QVariantMap &source, int actionId) const;
 
     WId m_winId = 0;
     QString m_serviceName; // original GMenu service (the gtk app)
@@ -123,5 +142,16 @@ private:
     Actions *m_unityActions = nullptr;
     Actions *m_windowActions = nullptr;
 
+    // Action names are looked up once and referred to by index afterwards
+    QHash<QString, int> m_actionIds;
+    QVector<InternedAction> m_internedActions;
+
+    // The translated tree, by DBusMenu id, patched as the GMenu and its actions change
+    QHash<int, TranslatedItem> m_translatedItems;
+    QHash<int, QSet<int>> m_itemsForAction;
+
+    // Clients only refetch a menu when they are announced a revision they didn't see for it yet
+    uint m_revision = 1;
+
     bool m_menuInited = false;
 };
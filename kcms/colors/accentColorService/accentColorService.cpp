@@ -28,6 +28,12 @@ void AccentColorService::setAccentColor(const QString &accentColor)
 {
     m_settings->load();
     if (QColor::isValidColor(accentColor) && m_settings->accentColorFromWallpaper()) {
+        // Wallpapers may send the same color again, e.g. on every slide of a slideshow.
+        // The setting alone can't tell, the KCM may have changed it since
+        if (QColor(accentColor) == m_lastAppliedColor && m_lastAppliedColor == m_settings->accentColor()) {
+            return;
+        }
+
         const QString path =
             QStandardPaths::locate(QStandardPaths::GenericDataLocation, QStringLiteral("color-schemes/%1.colors").arg(m_settings->colorScheme()));
 
@@ -44,6 +50,8 @@ void AccentColorService::setAccentColor(const QString &accentColor)
         m_settings->save();
         applyScheme(path, m_settings->config(), KConfig::Notify);
         notifyKcmChange(GlobalChangeType::PaletteChanged);
+
+        m_lastAppliedColor = QColor(accentColor);
     }
 }
 
@@ -10,6 +10,8 @@
 
 #include <kdedmodule.h>
 
+#include <QColor>
+
 class AccentColorService : public KDEDModule
 {
     Q_OBJECT
@@ -22,4 +24,6 @@ public Q_SLOTS:
 
 private:
     ColorsSettings *m_settings;
+    // The color applied by this service last, invalid until it applied one
+    QColor m_lastAppliedColor;
 };
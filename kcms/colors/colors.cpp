@@ -60,6 +60,9 @@ KCMColors::KCMColors(QObject *parent, const KPluginMetaData &data, const QVarian
     qmlRegisterAnonymousType<FilterProxyModel>(uri, 1);
     qmlRegisterAnonymousType<ColorsSettings>(uri, 1);
 
+    // Names and previews of schemes not seen before are filled in as they are parsed
+    m_model->setParseSchemes(true);
+
     connect(m_model, &ColorsModel::pendingDeletionsChanged, this, &KCMColors::settingsChanged);
 
     connect(m_model, &ColorsModel::selectedSchemeChanged, this, [this](const QString &scheme) {
@@ -10,17 +10,113 @@
 #include "colorsmodel.h"
 
 #include <QCollator>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
+#include <QFutureWatcher>
+#include <QLocale>
+#include <QSaveFile>
 #include <QStandardPaths>
+#include <QtConcurrentRun>
 
 #include <KColorScheme>
 #include <KConfigGroup>
 #include <KSharedConfig>
 
 #include <algorithm>
+#include <numeric>
 
 #include "colorsapplicator.h"
 
+namespace
+{
+// bump whenever the stored data changes
+const quint32 s_cacheVersion = 1;
+
+// Small enough for the list to fill up progressively, large enough to not drown in jobs
+const int s_parseBatchSize = 16;
+
+QString cacheFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/kcm_colors/schemes.cache");
+}
+
+QString cacheLocale()
+{
+    return QLocale().name() + QLatin1Char('|') + QString::fromLocal8Bit(qgetenv("LANGUAGE"));
+}
+
+// Case-insensitive, by name
+struct DisplayLessThan {
+    DisplayLessThan()
+    {
+        collator.setCaseSensitivity(Qt::CaseInsensitive);
+    }
+
+    bool operator()(const ColorsModelData &a, const ColorsModelData &b) const
+    {
+        return collator.compare(a.display, b.display) < 0;
+    }
+
+    QCollator collator;
+};
+
+ColorsModelData placeholderItem(const QString &baseName)
+{
+    return ColorsModelData{
+        baseName,
+        baseName,
+        QPalette(),
+        QColor(),
+        QColor(),
+        false, // removable
+        false, // accent active titlebar
+        false, // pending deletion
+        false, // tints
+        DefaultTintFactor,
+    };
+}
+
+// Runs in a worker thread
+ColorsModelData parseScheme(const QString &schemeFile)
+{
+    const QFileInfo fi(schemeFile);
+    const QString baseName = fi.baseName();
+
+    KSharedConfigPtr config = KSharedConfig::openConfig(schemeFile, KConfig::SimpleConfig);
+    KConfigGroup group(config, "General");
+    const QString name = group.readEntry("Name", baseName);
+
+    const QPalette palette = KColorScheme::createApplicationPalette(config);
+
+    QColor activeTitleBarBackground, activeTitleBarForeground;
+    if (KColorScheme::isColorSetSupported(config, KColorScheme::Header)) {
+        KColorScheme headerColorScheme(QPalette::Active, KColorScheme::Header, config);
+        activeTitleBarBackground = headerColorScheme.background().color();
+        activeTitleBarForeground = headerColorScheme.foreground().color();
+    } else {
+        KConfigGroup wmConfig(config, QStringLiteral("WM"));
+        activeTitleBarBackground = wmConfig.readEntry("activeBackground", palette.color(QPalette::Active, QPalette::Highlight));
+        activeTitleBarForeground = wmConfig.readEntry("activeForeground", palette.color(QPalette::Active, QPalette::HighlightedText));
+    }
+
+    const bool colorActiveTitleBar = group.readEntry("accentActiveTitlebar", false);
+
+    return ColorsModelData{
+        name,
+        baseName,
+        palette,
+        activeTitleBarBackground,
+        activeTitleBarForeground,
+        fi.isWritable(),
+        colorActiveTitleBar,
+        false, // pending deletion
+        group.hasKey("TintFactor"),
+        group.readEntry<qreal>("TintFactor", DefaultTintFactor),
+    };
+}
+}
+
 ColorsModel::ColorsModel(QObject *parent)
     : QAbstractListModel(parent)
 {
@@ -153,14 +249,25 @@ int ColorsModel::selectedSchemeIndex() const
     return indexOfScheme(m_selectedScheme);
 }
 
+void ColorsModel::setParseSchemes(bool parse)
+{
+    m_parseSchemes = parse;
+}
+
 void ColorsModel::load()
 {
+    loadCache();
+
     beginResetModel();
 
     const int oldCount = m_data.count();
 
     m_data.clear();
 
+    // Results of parsing still going on for a previous load are of no use anymore
+    ++m_generation;
+    m_pendingJobs = 0;
+
     QStringList schemeFiles;
 
     const QStringList schemeDirs =
@@ -180,51 +287,38 @@ void ColorsModel::load()
         return QStandardPaths::locate(QStandardPaths::GenericDataLocation, item);
     });
 
-    for (const QString &schemeFile : schemeFiles) {
-        const QFileInfo fi(schemeFile);
-        const QString baseName = fi.baseName();
+    // Only keep the schemes that are still around
+    QHash<QString, CachedScheme> cache;
+    QStringList unparsedFiles;
 
-        KSharedConfigPtr config = KSharedConfig::openConfig(schemeFile, KConfig::SimpleConfig);
-        KConfigGroup group(config, "General");
-        const QString name = group.readEntry("Name", baseName);
+    for (const QString &schemeFile : qAsConst(schemeFiles)) {
+        const QFileInfo fi(schemeFile);
 
-        const QPalette palette = KColorScheme::createApplicationPalette(config);
+        ColorsModelData item;
 
-        QColor activeTitleBarBackground, activeTitleBarForeground;
-        if (KColorScheme::isColorSetSupported(config, KColorScheme::Header)) {
-            KColorScheme headerColorScheme(QPalette::Active, KColorScheme::Header, config);
-            activeTitleBarBackground = headerColorScheme.background().color();
-            activeTitleBarForeground = headerColorScheme.foreground().color();
+        auto it = m_cache.constFind(schemeFile);
+        if (it != m_cache.constEnd() && it->lastModified == fi.lastModified().toMSecsSinceEpoch() && it->size == fi.size()) {
+            item = it->data;
+            cache.insert(schemeFile, *it);
         } else {
-            KConfigGroup wmConfig(config, QStringLiteral("WM"));
-            activeTitleBarBackground = wmConfig.readEntry("activeBackground", palette.color(QPalette::Active, QPalette::Highlight));
-            activeTitleBarForeground = wmConfig.readEntry("activeForeground", palette.color(QPalette::Active, QPalette::HighlightedText));
+            // Listed under its file name until it has been parsed
+            item = placeholderItem(fi.baseName());
+            unparsedFiles.append(schemeFile);
         }
 
-        const bool colorActiveTitleBar = group.readEntry("accentActiveTitlebar", false);
-
-        ColorsModelData item{
-            name,
-            baseName,
-            palette,
-            activeTitleBarBackground,
-            activeTitleBarForeground,
-            fi.isWritable(),
-            colorActiveTitleBar,
-            false, // pending deletion
-            group.hasKey("TintFactor"),
-            group.readEntry<qreal>("TintFactor", DefaultTintFactor),
-        };
+        item.schemeName = fi.baseName();
+        item.removable = fi.isWritable();
+        item.pendingDeletion = false;
 
         m_data.append(item);
     }
 
-    // Sort case-insensitively
-    QCollator collator;
-    collator.setCaseSensitivity(Qt::CaseInsensitive);
-    std::sort(m_data.begin(), m_data.end(), [&collator](const ColorsModelData &a, const ColorsModelData &b) {
-        return collator.compare(a.display, b.display) < 0;
-    });
+    if (cache.count() != m_cache.count()) {
+        m_cacheDirty = true;
+    }
+    m_cache = cache;
+
+    std::sort(m_data.begin(), m_data.end(), DisplayLessThan());
 
     endResetModel();
 
@@ -232,6 +326,196 @@ void ColorsModel::load()
     if (oldCount != m_data.count()) {
         Q_EMIT selectedSchemeIndexChanged();
     }
+
+    // The scheme names are all a command line tool needs
+    if (!m_parseSchemes) {
+        unparsedFiles.clear();
+    }
+
+    // Parse the remaining schemes in batches, so they show up as they come in rather than all at once
+    const int generation = m_generation;
+    for (int i = 0; i < unparsedFiles.count(); i += s_parseBatchSize) {
+        const QStringList batch = unparsedFiles.mid(i, s_parseBatchSize);
+
+        auto *watcher = new QFutureWatcher<QVector<QPair<QString, CachedScheme>>>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, generation] {
+            schemesParsed(generation, watcher->result());
+            watcher->deleteLater();
+        });
+
+        watcher->setFuture(QtConcurrent::run([batch] {
+            QVector<QPair<QString, CachedScheme>> schemes;
+            schemes.reserve(batch.count());
+
+            for (const QString &schemeFile : batch) {
+                // Taken before reading, so that a concurrent modification is noticed the next time
+                const QFileInfo fi(schemeFile);
+                schemes.append(qMakePair(schemeFile, CachedScheme{fi.lastModified().toMSecsSinceEpoch(), fi.size(), parseScheme(schemeFile)}));
+            }
+
+            return schemes;
+        }));
+
+        ++m_pendingJobs;
+    }
+
+    if (m_pendingJobs == 0) {
+        saveCache();
+    }
+}
+
+void ColorsModel::schemesParsed(int generation, const QVector<QPair<QString, CachedScheme>> &schemes)
+{
+    if (generation != m_generation) {
+        return;
+    }
+
+    --m_pendingJobs;
+
+    for (const auto &scheme : schemes) {
+        m_cache.insert(scheme.first, scheme.second);
+        m_cacheDirty = true;
+
+        const int row = indexOfScheme(scheme.second.data.schemeName);
+        if (row == -1) {
+            continue;
+        }
+
+        auto &item = m_data[row];
+
+        const bool removable = item.removable;
+        const bool pendingDeletion = item.pendingDeletion;
+
+        item = scheme.second.data;
+        item.removable = removable;
+        item.pendingDeletion = pendingDeletion;
+
+        const QModelIndex idx = index(row, 0);
+        Q_EMIT dataChanged(idx, idx);
+    }
+
+    // The display name is only known now
+    sortItems();
+
+    if (m_pendingJobs == 0) {
+        saveCache();
+    }
+}
+
+void ColorsModel::sortItems()
+{
+    const DisplayLessThan lessThan;
+
+    if (std::is_sorted(m_data.cbegin(), m_data.cend(), lessThan)) {
+        return;
+    }
+
+    Q_EMIT layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    QVector<int> order(m_data.count());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this, &lessThan](int a, int b) {
+        return lessThan(m_data.at(a), m_data.at(b));
+    });
+
+    QVector<ColorsModelData> sorted;
+    sorted.reserve(m_data.count());
+    QVector<int> newRows(m_data.count());
+    for (int row = 0; row < order.count(); ++row) {
+        newRows[order.at(row)] = row;
+        sorted.append(m_data.at(order.at(row)));
+    }
+    m_data = sorted;
+
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.count());
+    for (const QModelIndex &oldIndex : oldIndexes) {
+        newIndexes.append(index(newRows.at(oldIndex.row()), oldIndex.column()));
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    Q_EMIT layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    Q_EMIT selectedSchemeIndexChanged();
+}
+
+void ColorsModel::loadCache()
+{
+    if (m_cacheLoaded) {
+        return;
+    }
+    m_cacheLoaded = true;
+
+    QFile file(cacheFileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 version = 0;
+    QString locale;
+    stream >> version >> locale;
+    // Names are read translated
+    if (version != s_cacheVersion || locale != cacheLocale()) {
+        return;
+    }
+
+    qint32 count = 0;
+    stream >> count;
+
+    for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        CachedScheme scheme;
+        ColorsModelData &data = scheme.data;
+
+        stream >> path >> scheme.lastModified >> scheme.size;
+        stream >> data.display >> data.palette >> data.activeTitleBarBackground >> data.activeTitleBarForeground;
+        stream >> data.accentActiveTitlebar >> data.tints >> data.tintFactor;
+
+        data.schemeName = QFileInfo(path).baseName();
+        data.removable = false;
+        data.pendingDeletion = false;
+
+        m_cache.insert(path, scheme);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        m_cache.clear();
+    }
+}
+
+void ColorsModel::saveCache()
+{
+    if (!m_cacheDirty) {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(cacheFileName()).path());
+
+    QSaveFile file(cacheFileName());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    stream << s_cacheVersion << cacheLocale() << qint32(m_cache.count());
+
+    for (auto it = m_cache.cbegin(); it != m_cache.cend(); ++it) {
+        const ColorsModelData &data = it->data;
+
+        stream << it.key() << it->lastModified << it->size;
+        stream << data.display << data.palette << data.activeTitleBarBackground << data.activeTitleBarForeground;
+        stream << data.accentActiveTitlebar << data.tints << data.tintFactor;
+    }
+
+    if (file.commit()) {
+        m_cacheDirty = false;
+    }
 }
 
 QStringList ColorsModel::pendingDeletions() const
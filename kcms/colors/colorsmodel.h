@@ -10,6 +10,7 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QPalette>
 #include <QString>
 #include <QVector>
@@ -66,6 +67,13 @@ public:
     QStringList pendingDeletions() const;
     void removeItemsPendingDeletion();
 
+    /**
+     * Whether load() parses the schemes missing from the cache in the background,
+     * for their names and palettes. Off by default, as only the KCM shows those,
+     * command line tools get by with the file names.
+     */
+    void setParseSchemes(bool parse);
+
     void load();
 
 Q_SIGNALS:
@@ -75,7 +83,31 @@ Q_SIGNALS:
     void pendingDeletionsChanged();
 
 private:
+    // What is known about a scheme file, to avoid parsing it again while it is unchanged
+    struct CachedScheme {
+        qint64 lastModified;
+        qint64 size;
+        ColorsModelData data;
+    };
+
+    void schemesParsed(int generation, const QVector<QPair<QString, CachedScheme>> &schemes);
+    void sortItems();
+
+    void loadCache();
+    void saveCache();
+
     QString m_selectedScheme;
 
     QVector<ColorsModelData> m_data;
+
+    // Keyed by scheme file path
+    QHash<QString, CachedScheme> m_cache;
+    bool m_cacheLoaded = false;
+    bool m_cacheDirty = false;
+
+    bool m_parseSchemes = false;
+
+    // Parse results of an outdated load() are dropped
+    int m_generation = 0;
+    int m_pendingJobs = 0;
 };
@@ -14,6 +14,7 @@
 #include "krdb.h"
 
 #include "xcursor/cursortheme.h"
+#include "xcursor/previewcache.h"
 #include "xcursor/previewwidget.h"
 #include "xcursor/sortproxymodel.h"
 #include "xcursor/themeapplicator.h"
@@ -75,6 +76,14 @@ CursorThemeConfig::CursorThemeConfig(QObject *parent, const KPluginMetaData &dat
         setCanInstall(false);
     }
 
+    // The themes are inserted once they are scanned, the sizes of the current one are only known then
+    connect(m_themeModel, &CursorThemeModel::loadingChanged, this, [this] {
+        if (!m_themeModel->isLoading()) {
+            updateSizeComboBox();
+        }
+        Q_EMIT loadingThemesChanged();
+    });
+
     connect(m_themeModel, &QAbstractItemModel::dataChanged, this, &CursorThemeConfig::settingsChanged);
     connect(m_themeModel, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &start, const QModelIndex &end, const QVector<int> &roles) {
         const QModelIndex currentThemeIndex = m_themeModel->findIndex(cursorThemeSettings()->cursorTheme());
@@ -158,6 +167,11 @@ bool CursorThemeConfig::downloadingFile() const
     return m_tempCopyJob;
 }
 
+bool CursorThemeConfig::loadingThemes() const
+{
+    return m_themeModel->isLoading();
+}
+
 QAbstractItemModel *CursorThemeConfig::cursorsModel()
 {
     return m_themeProxyModel;
@@ -481,6 +495,7 @@ void CursorThemeConfig::removeThemes()
 
         // Delete the theme from the harddrive
         KIO::del(QUrl::fromLocalFile(theme->path())); // async
+        PreviewCache::remove(theme->name());
 
         // Remove the theme from the model
         m_themeModel->removeTheme(idx);
@@ -36,6 +36,7 @@ class CursorThemeConfig : public KQuickAddons::ManagedConfigModule
     Q_PROPERTY(bool canConfigure READ canConfigure WRITE setCanConfigure NOTIFY canConfigureChanged)
     Q_PROPERTY(QAbstractItemModel *cursorsModel READ cursorsModel CONSTANT)
     Q_PROPERTY(QAbstractItemModel *sizesModel READ sizesModel CONSTANT)
+    Q_PROPERTY(bool loadingThemes READ loadingThemes NOTIFY loadingThemesChanged)
 
     Q_PROPERTY(bool downloadingFile READ downloadingFile NOTIFY downloadingFileChanged)
     Q_PROPERTY(int preferredSize READ preferredSize WRITE setPreferredSize NOTIFY preferredSizeChanged)
@@ -68,6 +69,8 @@ public:
     QAbstractItemModel *cursorsModel();
     QAbstractItemModel *sizesModel();
 
+    bool loadingThemes() const;
+
     Q_INVOKABLE int cursorSizeIndex(int cursorSize) const;
     Q_INVOKABLE int cursorSizeFromIndex(int index);
     Q_INVOKABLE int cursorThemeIndex(const QString &cursorTheme) const;
@@ -79,6 +82,7 @@ Q_SIGNALS:
     void canConfigureChanged();
     void downloadingFileChanged();
     void preferredSizeChanged();
+    void loadingThemesChanged();
     void themeApplied();
 
     void showSuccessMessage(const QString &message);
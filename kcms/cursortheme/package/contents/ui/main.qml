@@ -21,9 +21,13 @@ KCM.GridViewKCM {
 
     view.model: kcm.cursorsModel
     view.delegate: Delegate {}
-    view.currentIndex: kcm.cursorThemeIndex(kcm.cursorThemeSettings.cursorTheme);
+    // the themes are inserted once they are scanned, don't let the view pick one meanwhile
+    view.currentIndex: kcm.loadingThemes ? -1 : kcm.cursorThemeIndex(kcm.cursorThemeSettings.cursorTheme);
 
     view.onCurrentIndexChanged: {
+        if (kcm.loadingThemes) {
+            return;
+        }
         kcm.cursorThemeSettings.cursorTheme = kcm.cursorThemeFromIndex(view.currentIndex)
         view.positionViewAtIndex(view.currentIndex, view.GridView.Beginning);
     }
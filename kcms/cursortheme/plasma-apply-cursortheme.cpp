@@ -72,6 +72,7 @@ int main(int argc, char **argv)
     CursorThemeSettings *settings = new CursorThemeSettings(&app);
     QTextStream ts(stdout);
     CursorThemeModel *model = new CursorThemeModel(&app);
+    model->waitForThemes();
     if (!parser->positionalArguments().isEmpty()) {
         QString requestedTheme{parser->positionalArguments().first()};
         const QString dirSplit{"/"};
@@ -41,7 +41,7 @@ QPixmap CursorTheme::icon() const
     return m_icon;
 }
 
-QImage CursorTheme::autoCropImage(const QImage &image) const
+QImage CursorTheme::autoCropImage(const QImage &image)
 {
     // Compute an autocrop rectangle for the image
     QRect r(image.rect().bottomRight(), image.rect().topLeft());
@@ -165,7 +165,7 @@ protected:
     }
 
     /// Convenience function for cropping an image.
-    QImage autoCropImage(const QImage &image) const;
+    static QImage autoCropImage(const QImage &image);
 
     // Convenience function that uses Xfixes to tag a cursor with a name
     void setCursorName(qulonglong cursor, const QString &name) const;
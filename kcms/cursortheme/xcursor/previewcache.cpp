@@ -0,0 +1,196 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+*/
+
+#include "previewcache.h"
+#include "xcursortheme.h"
+
+#include <KConfig>
+#include <KConfigGroup>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QPainter>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+
+#include <X11/Xcursor/Xcursor.h>
+
+namespace
+{
+// bump whenever the way previews are loaded or stored changes
+const QString s_cacheVersion = QStringLiteral("1");
+
+QString cacheFolder()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/kcm_cursortheme/previews/");
+}
+
+QString cacheFilePrefix(const QString &themeName)
+{
+    return QString::fromLatin1(QUrl::toPercentEncoding(themeName)) + QLatin1Char('@');
+}
+
+// Xcursor falls back to the inherited themes for missing cursors, their folders count as well
+void collectThemeFolders(const QString &themePath, QStringList &folders, int depth = 0)
+{
+    // Prevent infinite recursion
+    if (depth > 10 || folders.contains(themePath)) {
+        return;
+    }
+    folders << themePath;
+
+    if (!QFileInfo::exists(themePath + QStringLiteral("/index.theme"))) {
+        return;
+    }
+
+    KConfig config(themePath + QStringLiteral("/index.theme"), KConfig::NoGlobals);
+    KConfigGroup cg(&config, "Icon Theme");
+    const QStringList inherits = cg.readEntry("Inherits", QStringList());
+    if (inherits.isEmpty()) {
+        return;
+    }
+
+    const QStringList baseDirs = QString::fromLocal8Bit(XcursorLibraryPath()).split(QLatin1Char(':'), Qt::SkipEmptyParts);
+    for (const QString &inherit : inherits) {
+        for (QString baseDir : baseDirs) {
+            if (baseDir.startsWith(QLatin1String("~/"))) {
+                baseDir.replace(0, 1, QDir::homePath());
+            }
+            const QString inheritPath = baseDir + QLatin1Char('/') + inherit;
+            if (QFileInfo(inheritPath).isDir()) {
+                collectThemeFolders(inheritPath, folders, depth + 1);
+            }
+        }
+    }
+}
+
+// Identifies the state of the theme, the themes it inherits, and the cursors a preview was made of
+QString cacheKey(const QString &themePath, const QStringList &cursorNames)
+{
+    QStringList folders;
+    collectThemeFolders(themePath, folders);
+
+    qint64 timeStamp = 0;
+    for (const QString &folder : qAsConst(folders)) {
+        for (const QString &path : {folder, folder + QStringLiteral("/cursors"), folder + QStringLiteral("/index.theme")}) {
+            const QFileInfo info(path);
+            if (info.exists()) {
+                timeStamp = qMax(timeStamp, info.lastModified().toMSecsSinceEpoch());
+            }
+        }
+    }
+
+    const QByteArray names = QCryptographicHash::hash(cursorNames.join(QLatin1Char(',')).toUtf8(), QCryptographicHash::Md5).toHex();
+    return QString::number(timeStamp) + QLatin1Char('-') + QString::fromLatin1(names);
+}
+
+// The previews are stored side by side in one image, their sizes and the cache key in its text fields
+QVector<QImage> load(const QString &fileName, const QString &key, int count)
+{
+    const QImage atlas(fileName);
+    if (atlas.isNull() || atlas.text(QStringLiteral("Version")) != s_cacheVersion || atlas.text(QStringLiteral("Key")) != key) {
+        return {};
+    }
+
+    const QStringList sizes = atlas.text(QStringLiteral("Sizes")).split(QLatin1Char(','));
+    if (sizes.count() != count) {
+        return {};
+    }
+
+    const int cellWidth = atlas.width() / count;
+
+    QVector<QImage> previews;
+    previews.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const QStringList size = sizes.at(i).split(QLatin1Char('x'));
+        const int width = size.value(0).toInt();
+        const int height = size.value(1).toInt();
+
+        if (width <= 0 || height <= 0) {
+            previews << QImage();
+            continue;
+        }
+        if (width > cellWidth || height > atlas.height()) {
+            return {};
+        }
+
+        previews << atlas.copy(i * cellWidth, 0, width, height).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    return previews;
+}
+
+void save(const QString &fileName, const QString &key, const QVector<QImage> &previews)
+{
+    QStringList sizes;
+    int cellWidth = 1;
+    int cellHeight = 1;
+
+    for (const QImage &preview : previews) {
+        sizes << QString::number(preview.width()) + QLatin1Char('x') + QString::number(preview.height());
+        cellWidth = qMax(cellWidth, preview.width());
+        cellHeight = qMax(cellHeight, preview.height());
+    }
+
+    QImage atlas(cellWidth * previews.count(), cellHeight, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+
+    QPainter p(&atlas);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    for (int i = 0; i < previews.count(); ++i) {
+        if (!previews.at(i).isNull()) {
+            p.drawImage(i * cellWidth, 0, previews.at(i));
+        }
+    }
+    p.end();
+
+    atlas.setText(QStringLiteral("Version"), s_cacheVersion);
+    atlas.setText(QStringLiteral("Key"), key);
+    atlas.setText(QStringLiteral("Sizes"), sizes.join(QLatin1Char(',')));
+
+    QDir().mkpath(cacheFolder());
+
+    QSaveFile file(fileName);
+    if (file.open(QIODevice::WriteOnly) && atlas.save(&file, "PNG")) {
+        file.commit();
+    }
+}
+}
+
+namespace PreviewCache
+{
+QVector<QImage> previews(const QString &themeName, const QString &themePath, const QStringList &cursorNames, int size)
+{
+    const QString fileName = cacheFolder() + cacheFilePrefix(themeName) + QString::number(size) + QStringLiteral(".png");
+    const QString key = cacheKey(themePath, cursorNames);
+
+    QVector<QImage> previews = load(fileName, key, cursorNames.count());
+    if (!previews.isEmpty()) {
+        return previews;
+    }
+
+    previews.reserve(cursorNames.count());
+    for (const QString &cursorName : cursorNames) {
+        previews << XCursorTheme::loadThemeImage(themeName, cursorName, size);
+    }
+
+    save(fileName, key, previews);
+    return previews;
+}
+
+void remove(const QString &themeName)
+{
+    QDir folder(cacheFolder());
+    const QStringList files = folder.entryList({cacheFilePrefix(themeName) + QLatin1Char('*')}, QDir::Files);
+    for (const QString &file : files) {
+        folder.remove(file);
+    }
+}
+}
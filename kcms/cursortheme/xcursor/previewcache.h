@@ -0,0 +1,35 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+*/
+
+#pragma once
+
+#include <QImage>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * Preview images of cursor themes, as shown in the theme grid.
+ *
+ * Loading a cursor means looking it up through the Xcursor library path, reading
+ * all its sizes and frames, and cropping it. The cropped first frames shown in the
+ * previews are stored on disk, one image atlas per theme and size, and trusted until
+ * the folder of the theme or of a theme it inherits is modified.
+ *
+ * All functions can be called from any thread.
+ */
+namespace PreviewCache
+{
+/**
+ * The autocropped first frames of the cursors @p cursorNames, with the nominal size @p size,
+ * of the theme @p themeName located at @p themePath. A null image where the theme lacks the cursor.
+ */
+QVector<QImage> previews(const QString &themeName, const QString &themePath, const QStringList &cursorNames, int size);
+
+/**
+ * Removes the stored previews of a theme, to be called when it is uninstalled
+ */
+void remove(const QString &themeName);
+}
@@ -8,12 +8,14 @@
 #include <QPainter>
 #include <QQuickRenderControl>
 #include <QQuickWindow>
+#include <QtConcurrentRun>
 
 #include <KWindowSystem>
 
 #include "previewwidget.h"
 
 #include "cursortheme.h"
+#include "previewcache.h"
 
 namespace
 {
@@ -44,7 +46,7 @@ const qreal widgetMinHeight = 48; // The minimum height of the preview widget
 class PreviewCursor
 {
 public:
-    PreviewCursor(const CursorTheme *theme, const QString &name, int size);
+    PreviewCursor(const QString &name, const QImage &image, int size);
 
     const QPixmap &pixmap() const
     {
@@ -83,21 +85,30 @@ public:
     {
         return m_images;
     }
+    // Loads all the frames of the cursor, for animating it
+    void loadImages(const CursorTheme *theme)
+    {
+        if (m_images.empty() && theme) {
+            m_images = theme->loadImages(m_name, m_boundingSize);
+        }
+    }
+
 private:
+    QString m_name;
     int m_boundingSize;
     QPixmap m_pixmap;
     std::vector<CursorTheme::CursorImage> m_images;
     QPoint m_pos;
 };
 
-PreviewCursor::PreviewCursor(const CursorTheme *theme, const QString &name, int size)
-    : m_boundingSize(size > 0 ? size : theme->defaultCursorSize())
-    , m_images(theme->loadImages(name, size))
+PreviewCursor::PreviewCursor(const QString &name, const QImage &image, int size)
+    : m_name(name)
+    , m_boundingSize(size)
 {
-    if (m_images.empty())
+    if (image.isNull())
         return;
 
-    m_pixmap = QPixmap::fromImage(m_images.front().image);
+    m_pixmap = QPixmap::fromImage(image);
 }
 
 QRect PreviewCursor::rect() const
@@ -119,6 +130,7 @@ PreviewWidget::PreviewWidget(QQuickItem *parent)
         m_animationTimer.setInterval(current->images().at(nextAnimationFrame).delay);
         nextAnimationFrame = (nextAnimationFrame + 1) % current->images().size();
     });
+    connect(&m_previewWatcher, &QFutureWatcher<QVector<QImage>>::finished, this, &PreviewWidget::previewsLoaded);
 }
 
 PreviewWidget::~PreviewWidget()
@@ -233,18 +245,45 @@ void PreviewWidget::layoutItems()
 
 void PreviewWidget::setTheme(const CursorTheme *theme, const int size)
 {
+    m_animationTimer.stop();
     qDeleteAll(list);
     list.clear();
+    current = nullptr;
 
     if (theme) {
+        // Only the theme name and path go to the thread, the theme may be gone by the time it runs
+        const QString themeName = theme->name();
+        const QString themePath = theme->path();
+        QStringList names;
         for (int i = 0; i < numCursors; i++)
-            list << new PreviewCursor(theme, cursor_names[i], size);
+            names << QString::fromLatin1(cursor_names[i]);
+
+        m_previewSize = size > 0 ? size : theme->defaultCursorSize();
+        m_previewWatcher.setFuture(QtConcurrent::run([themeName, themePath, names, size = m_previewSize] {
+            return PreviewCache::previews(themeName, themePath, names, size);
+        }));
+    } else {
+        m_previewWatcher.setFuture(QFuture<QVector<QImage>>());
+    }
 
-        needLayout = true;
-        updateImplicitSize();
+    update();
+}
+
+void PreviewWidget::previewsLoaded()
+{
+    if (m_previewWatcher.isCanceled() || m_previewWatcher.future().resultCount() == 0) {
+        return;
     }
 
-    current = nullptr;
+    const QVector<QImage> images = m_previewWatcher.result();
+
+    qDeleteAll(list);
+    list.clear();
+    for (int i = 0; i < images.count(); i++)
+        list << new PreviewCursor(QString::fromLatin1(cursor_names[i]), images.at(i), m_previewSize);
+
+    needLayout = true;
+    updateImplicitSize();
     update();
 }
 
@@ -269,7 +308,7 @@ void PreviewWidget::hoverMoveEvent(QHoverEvent *e)
     auto it = std::find_if(list.cbegin(), list.cend(), [e](const PreviewCursor *c) {
         return c->rect().contains(e->pos());
     });
-    const PreviewCursor *cursor = it != list.cend() ? *it : nullptr;
+    PreviewCursor *cursor = it != list.cend() ? *it : nullptr;
 
     if (cursor == std::exchange(current, cursor)) {
         return;
@@ -281,6 +320,10 @@ void PreviewWidget::hoverMoveEvent(QHoverEvent *e)
         return;
     }
 
+    if (m_themeModel) {
+        current->loadImages(m_themeModel->theme(m_themeModel->index(m_currentIndex, 0)));
+    }
+
     if (current->images().size() <= 1) {
         setCursor(QCursor(current->pixmap()));
         return;
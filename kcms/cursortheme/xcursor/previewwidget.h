@@ -7,6 +7,7 @@
 #pragma once
 
 #include "sortproxymodel.h"
+#include <QFutureWatcher>
 #include <QPointer>
 #include <QQuickPaintedItem>
 #include <QTimer>
@@ -57,13 +58,17 @@ protected:
 
 private:
     void layoutItems();
+    void previewsLoaded();
 
     QList<PreviewCursor *> list;
-    const PreviewCursor *current;
+    PreviewCursor *current;
     bool needLayout : 1;
     QPointer<SortProxyModel> m_themeModel;
     int m_currentIndex;
     int m_currentSize;
     QTimer m_animationTimer;
     size_t nextAnimationFrame;
+    // The first frames of the cursors are loaded in a thread, the others when hovered
+    QFutureWatcher<QVector<QImage>> m_previewWatcher;
+    int m_previewSize = 0;
 };
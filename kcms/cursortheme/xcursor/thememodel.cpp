@@ -9,6 +9,8 @@
 #include <KLocalizedString>
 #include <QDir>
 #include <QRegularExpression>
+#include <QSet>
+#include <QtConcurrentMap>
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #include <private/qtx11extras_p.h>
 #else
@@ -21,6 +23,8 @@
 #include <X11/Xcursor/Xcursor.h>
 #include <X11/Xlib.h>
 
+#include <functional>
+
 // Check for older version
 #if !defined(XCURSOR_LIB_MAJOR) && defined(XCURSOR_MAJOR)
 #define XCURSOR_LIB_MAJOR XCURSOR_MAJOR
@@ -35,6 +39,12 @@ CursorThemeModel::CursorThemeModel(QObject *parent)
 
 CursorThemeModel::~CursorThemeModel()
 {
+    // The workers use baseDirs
+    if (loadingWatcher) {
+        loadingWatcher->waitForFinished();
+        qDeleteAll(loadingWatcher->future().results());
+    }
+
     qDeleteAll(list);
     list.clear();
 }
@@ -59,6 +69,19 @@ void CursorThemeModel::refreshList()
     insertThemes();
 }
 
+bool CursorThemeModel::isLoading() const
+{
+    return loadingWatcher;
+}
+
+void CursorThemeModel::waitForThemes()
+{
+    if (loadingWatcher) {
+        loadingWatcher->waitForFinished();
+        themesLoaded();
+    }
+}
+
 QVariant CursorThemeModel::data(const QModelIndex &index, int role) const
 {
     if (!index.isValid() || index.row() < 0 || index.row() >= list.count())
@@ -193,14 +216,14 @@ bool CursorThemeModel::hasTheme(const QString &name) const
     return false;
 }
 
-bool CursorThemeModel::isCursorTheme(const QString &theme, const int depth)
+bool CursorThemeModel::isCursorTheme(const QString &theme, const int depth) const
 {
     // Prevent infinite recursion
     if (depth > 10)
         return false;
 
     // Search each icon theme directory for 'theme'
-    foreach (const QString &baseDir, searchPaths()) {
+    foreach (const QString &baseDir, baseDirs) {
         QDir dir(baseDir);
         if (!dir.exists() || !dir.cd(theme))
             continue;
@@ -260,22 +283,15 @@ bool CursorThemeModel::handleDefault(const QDir &themeDir)
     return false;
 }
 
-void CursorThemeModel::processThemeDir(const QDir &themeDir)
+// Called from worker threads, must not touch anything but baseDirs
+XCursorTheme *CursorThemeModel::loadTheme(const QDir &themeDir) const
 {
     bool haveCursors = themeDir.exists(QStringLiteral("cursors"));
 
-    // Special case handling of "default", since it's usually either a
-    // symlink to another theme, or an empty theme that inherits another
-    // theme.
-    if (defaultName.isNull() && themeDir.dirName() == QLatin1String("default")) {
-        if (handleDefault(themeDir))
-            return;
-    }
-
     // If the directory doesn't have a cursors subdir and lacks an
     // index.theme file it can't be a cursor theme.
     if (!themeDir.exists(QStringLiteral("index.theme")) && !haveCursors)
-        return;
+        return nullptr;
 
     // Create a cursor theme object for the theme dir
     XCursorTheme *theme = new XCursorTheme(themeDir);
@@ -283,7 +299,7 @@ void CursorThemeModel::processThemeDir(const QDir &themeDir)
     // Skip this theme if it's hidden.
     if (theme->isHidden()) {
         delete theme;
-        return;
+        return nullptr;
     }
 
     // If there's no cursors subdirectory we'll do a recursive scan
@@ -297,41 +313,102 @@ void CursorThemeModel::processThemeDir(const QDir &themeDir)
 
         if (!foundCursorTheme) {
             delete theme;
-            return;
+            return nullptr;
         }
     }
 
-    // Append the theme to the list
-    beginInsertRows(QModelIndex(), list.size(), list.size());
-    list.append(theme);
-    endInsertRows();
+    return theme;
 }
 
 void CursorThemeModel::insertThemes()
 {
-    // Scan each base dir for Xcursor themes and add them to the list.
+    // Collect the subdirs of each base dir, in the order Xcursor searches them.
+    QStringList themeDirs;
     foreach (const QString &baseDir, searchPaths()) {
         QDir dir(baseDir);
         if (!dir.exists())
             continue;
 
-        // Process each subdir in the directory
         foreach (const QString &name, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-            // Don't process the theme if a theme with the same name already exists
-            // in the list. Xcursor will pick the first one it finds in that case,
-            // and since we use the same search order, the one Xcursor picks should
-            // be the one already in the list.
-            if (hasTheme(name) || !dir.cd(name))
-                continue;
+            themeDirs << dir.filePath(name);
+        }
+    }
+
+    // A scan started before has become stale, drop what it finds
+    const bool wasLoading = loadingWatcher;
+    if (loadingWatcher) {
+        loadingWatcher->disconnect(this);
+        loadingWatcher->waitForFinished();
+        qDeleteAll(loadingWatcher->future().results());
+        delete loadingWatcher;
+    }
+
+    // Parsing the index files and reading the cursors for their sizes is slow,
+    // so all the directories are loaded in parallel on the thread pool, and
+    // the themes are inserted once they are all done.
+    const std::function<XCursorTheme *(const QString &)> load = [this](const QString &themeDir) {
+        return loadTheme(QDir(themeDir));
+    };
+
+    loadingDirs = themeDirs;
+    loadingWatcher = new QFutureWatcher<XCursorTheme *>(this);
+    connect(loadingWatcher, &QFutureWatcherBase::finished, this, &CursorThemeModel::themesLoaded);
+    loadingWatcher->setFuture(QtConcurrent::mapped(loadingDirs, load));
+
+    if (!wasLoading) {
+        Q_EMIT loadingChanged();
+    }
+}
+
+void CursorThemeModel::themesLoaded()
+{
+    if (!loadingWatcher) {
+        return;
+    }
 
-            processThemeDir(dir);
-            dir.cdUp(); // Return to the base dir
+    const QList<XCursorTheme *> themes = loadingWatcher->future().results();
+    const QStringList themeDirs = loadingDirs;
+
+    QVector<CursorTheme *> newThemes;
+    QSet<QString> newNames;
+    for (int i = 0; i < themeDirs.count(); ++i) {
+        XCursorTheme *theme = themes.value(i);
+        const QDir themeDir(themeDirs.at(i));
+        const QString name = themeDir.dirName();
+
+        // Don't add the theme if a theme with the same name already exists
+        // in the list. Xcursor will pick the first one it finds in that case,
+        // and since we use the same search order, the one Xcursor picks should
+        // be the one already in the list.
+        // Special case handling of "default", since it's usually either a
+        // symlink to another theme, or an empty theme that inherits another
+        // theme.
+        if (hasTheme(name) || newNames.contains(name) || (defaultName.isNull() && name == QLatin1String("default") && handleDefault(themeDir)) || !theme) {
+            delete theme;
+            continue;
         }
+
+        newThemes << theme;
+        newNames.insert(name);
+    }
+
+    if (!newThemes.isEmpty()) {
+        beginInsertRows(QModelIndex(), list.size(), list.size() + newThemes.size() - 1);
+        for (CursorTheme *theme : qAsConst(newThemes))
+            list.append(theme);
+        endInsertRows();
     }
 
     // The theme Xcursor will end up using if no theme is configured
     if (defaultName.isNull() || !hasTheme(defaultName))
         defaultName = QStringLiteral("KDE_Classic");
+
+    // Only done loading now, views know to ignore the rows inserted meanwhile
+    loadingWatcher->deleteLater();
+    loadingWatcher = nullptr;
+    loadingDirs.clear();
+
+    Q_EMIT loadingChanged();
 }
 
 bool CursorThemeModel::addTheme(const QDir &dir)
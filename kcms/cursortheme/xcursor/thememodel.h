@@ -7,10 +7,12 @@
 #pragma once
 
 #include <QAbstractTableModel>
+#include <QFutureWatcher>
 #include <QStringList>
 
 class QDir;
 class CursorTheme;
+class XCursorTheme;
 
 /**
  * The CursorThemeModel class provides a model for all locally installed
@@ -36,6 +38,10 @@ class CursorTheme;
  *
  * Calling defaultIndex() will return the index of the theme Xcursor
  * will use if the user hasn't explicitly configured a cursor theme.
+ *
+ * The themes are scanned in worker threads, the model starts out empty and
+ * inserts them all at once when the scan is done. isLoading() tells whether
+ * a scan is running.
  */
 class CursorThemeModel : public QAbstractListModel
 {
@@ -70,18 +76,30 @@ public:
     /// Refresh the list of themes by checking what's on disk.
     void refreshList();
 
+    /// Returns @a true while the themes on disk are being scanned.
+    bool isLoading() const;
+
+    /// Blocks until the themes being scanned are inserted, for callers without an event loop.
+    void waitForThemes();
+
+Q_SIGNALS:
+    void loadingChanged();
+
 private:
     bool handleDefault(const QDir &dir);
-    void processThemeDir(const QDir &dir);
+    XCursorTheme *loadTheme(const QDir &dir) const;
     void insertThemes();
+    void themesLoaded();
     bool hasTheme(const QString &theme) const;
-    bool isCursorTheme(const QString &theme, const int depth = 0);
+    bool isCursorTheme(const QString &theme, const int depth = 0) const;
 
 private:
     QList<CursorTheme *> list;
     QStringList baseDirs;
     QString defaultName;
     QVector<CursorTheme *> pendingDeletions;
+    QStringList loadingDirs;
+    QFutureWatcher<XCursorTheme *> *loadingWatcher = nullptr;
 };
 
 int CursorThemeModel::rowCount(const QModelIndex &) const
@@ -22,9 +22,6 @@
 
 #include "xcursortheme.h"
 
-// Static variable holding alternative names for some cursors
-QHash<QString, QString> XCursorTheme::alternatives;
-
 XCursorTheme::XCursorTheme(const QDir &themeDir)
     : CursorTheme(themeDir.dirName())
 {
@@ -78,9 +75,11 @@ void XCursorTheme::parseIndexFile()
     m_inherits = cg.readEntry("Inherits", QStringList());
 }
 
-QString XCursorTheme::findAlternative(const QString &name) const
+QString XCursorTheme::findAlternative(const QString &name)
 {
-    if (alternatives.isEmpty()) {
+    // Alternative names for some cursors, initialized once in a thread safe manner
+    static const QHash<QString, QString> alternatives = [] {
+        QHash<QString, QString> alternatives;
         alternatives.reserve(18);
 
         // Qt uses non-standard names for some core cursors.
@@ -108,15 +107,17 @@ QString XCursorTheme::findAlternative(const QString &name) const
         alternatives.insert(QStringLiteral("hand2"), QStringLiteral("e29285e634086352946a0e7090d73106"));
         alternatives.insert(QStringLiteral("openhand"), QStringLiteral("9141b49c8149039304290b508d208c40"));
         alternatives.insert(QStringLiteral("closedhand"), QStringLiteral("05e88622050804100c20044008402080"));
-    }
+
+        return alternatives;
+    }();
 
     return alternatives.value(name, QString());
 }
 
-XcursorImage *XCursorTheme::xcLoadImage(const QString &image, int size) const
+XcursorImage *XCursorTheme::xcLoadImage(const QString &theme, const QString &image, int size)
 {
     QByteArray cursorName = QFile::encodeName(image);
-    QByteArray themeName = QFile::encodeName(name());
+    QByteArray themeName = QFile::encodeName(theme);
 
     return XcursorLibraryLoadImage(cursorName, themeName, size);
 }
@@ -191,11 +192,16 @@ QImage XCursorTheme::loadImage(const QString &name, int size) const
     if (size <= 0)
         size = defaultCursorSize();
 
+    return loadThemeImage(this->name(), name, size);
+}
+
+QImage XCursorTheme::loadThemeImage(const QString &themeName, const QString &name, int size)
+{
     // Load the image
-    XcursorImage *xcimage = xcLoadImage(name, size);
+    XcursorImage *xcimage = xcLoadImage(themeName, name, size);
 
     if (!xcimage)
-        xcimage = xcLoadImage(findAlternative(name), size);
+        xcimage = xcLoadImage(themeName, findAlternative(name), size);
 
     if (!xcimage) {
         return QImage();
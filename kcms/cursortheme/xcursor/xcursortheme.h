@@ -39,6 +39,10 @@ public:
     }
 
     QImage loadImage(const QString &name, int size = 0) const override;
+
+    /// Loads the autocropped cursor image @p name with the nominal size @p size from the
+    /// theme @p themeName. Unlike loadImage() this can be called from any thread.
+    static QImage loadThemeImage(const QString &themeName, const QString &name, int size);
     std::vector<CursorImage> loadImages(const QString &name, int size = 0) const override;
     qulonglong loadCursor(const QString &name, int size = 0) const override;
 
@@ -57,11 +61,10 @@ protected:
     }
 
 private:
-    XcursorImage *xcLoadImage(const QString &name, int size) const;
+    static XcursorImage *xcLoadImage(const QString &themeName, const QString &name, int size);
     XcursorImages *xcLoadImages(const QString &name, int size) const;
     void parseIndexFile();
-    QString findAlternative(const QString &name) const;
+    static QString findAlternative(const QString &name);
 
     QStringList m_inherits;
-    static QHash<QString, QString> alternatives;
 };
@@ -18,14 +18,13 @@
 
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QFutureWatcher>
 #include <QGuiApplication>
-#include <QPainter>
 #include <QPixmapCache>
 #include <QProcess>
 #include <QQuickItem>
 #include <QQuickWindow>
 #include <QStringList>
-#include <QSvgRenderer>
 
 #include <KConfigGroup>
 #include <KIconLoader>
@@ -46,6 +45,7 @@
 #include "iconsizecategorymodel.h"
 #include "iconsmodel.h"
 #include "iconssettings.h"
+#include "previewcache.h"
 
 #include "config.h" // for CMAKE_INSTALL_FULL_LIBEXECDIR
 
@@ -75,6 +75,10 @@ IconModule::IconModule(QObject *parent, const KPluginMetaData &data, const QVari
 
 IconModule::~IconModule()
 {
+    // the jobs write the preview cache, let them finish
+    for (QFutureWatcher<QVector<QImage>> *watcher : qAsConst(m_previewWatchers)) {
+        watcher->waitForFinished();
+    }
 }
 
 IconsSettings *IconModule::iconsSettings() const
@@ -152,6 +156,8 @@ void IconModule::processPendingDeletions()
         auto *job = KIO::del(QUrl::fromLocalFile(theme.dir()), KIO::HideProgressInfo);
         // needs to block for it to work on "OK" where the dialog (kcmshell) closes
         job->exec();
+
+        PreviewCache::remove(themeName);
     }
 
     m_model->removeItemsPendingDeletion();
@@ -288,49 +294,23 @@ bool IconModule::installThemes(const QStringList &themes, const QString &archive
     return everythingOk;
 }
 
-QVariantList IconModule::previewIcons(const QString &themeName, int size, qreal dpr, int limit)
+static QString previewCacheKey(const QString &themeName, int size, qreal dpr)
 {
-    static QVector<QStringList> s_previewIcons{
-        {QStringLiteral("system-run"), QStringLiteral("exec")},
-        {QStringLiteral("folder")},
-        {QStringLiteral("document"), QStringLiteral("text-x-generic")},
-        {QStringLiteral("user-trash"), QStringLiteral("user-trash-empty")},
-        {QStringLiteral("help-browser"), QStringLiteral("system-help"), QStringLiteral("help-about"), QStringLiteral("help-contents")},
-        {QStringLiteral("preferences-system"), QStringLiteral("systemsettings"), QStringLiteral("configure")},
-
-        {QStringLiteral("text-html")},
-        {QStringLiteral("image-x-generic"), QStringLiteral("image-png"), QStringLiteral("image-jpeg")},
-        {QStringLiteral("video-x-generic"), QStringLiteral("video-x-theora+ogg"), QStringLiteral("video-mp4")},
-        {QStringLiteral("x-office-document")},
-        {QStringLiteral("x-office-spreadsheet")},
-        {QStringLiteral("x-office-presentation"), QStringLiteral("application-presentation")},
-
-        {QStringLiteral("user-home")},
-        {QStringLiteral("user-desktop"), QStringLiteral("desktop")},
-        {QStringLiteral("folder-image"), QStringLiteral("folder-images"), QStringLiteral("folder-pictures"), QStringLiteral("folder-picture")},
-        {QStringLiteral("folder-documents")},
-        {QStringLiteral("folder-download"), QStringLiteral("folder-downloads")},
-        {QStringLiteral("folder-video"), QStringLiteral("folder-videos")}};
-
-    // created on-demand as it is quite expensive to do and we don't want to do it every loop iteration either
-    QScopedPointer<KIconTheme> theme;
+    return themeName + QLatin1Char('@') + QString::number(size) + QLatin1Char('@') + QString::number(dpr, 'f', 1);
+}
 
-    QVariantList pixmaps;
+QVariant IconModule::previewIcons(const QString &themeName, int size, qreal dpr, int limit)
+{
+    const QString cacheKey = previewCacheKey(themeName, size, dpr);
 
-    for (const QStringList &iconNames : s_previewIcons) {
-        const QString cacheKey = themeName + QLatin1Char('@') + QString::number(size) + QLatin1Char('@') + QString::number(dpr, 'f', 1) + QLatin1Char('@')
-            + iconNames.join(QLatin1Char(','));
+    QVariantList pixmaps;
 
+    for (int i = 0, count = PreviewCache::previewCount(); i < count; ++i) {
         QPixmap pix;
-        if (!QPixmapCache::find(cacheKey, &pix)) {
-            if (!theme) {
-                theme.reset(new KIconTheme(themeName));
-            }
-
-            pix = getBestIcon(*theme.data(), iconNames, size, dpr);
-
-            // Inserting a pixmap even if null so we know whether we searched for it already
-            QPixmapCache::insert(cacheKey, pix);
+        if (!QPixmapCache::find(cacheKey + QLatin1Char('@') + QString::number(i), &pix)) {
+            // loaded from disk or rendered in a worker thread, all previews of the theme at once
+            loadPreviewIcons(themeName, size, dpr);
+            return QVariant();
         }
 
         if (pix.isNull()) {
@@ -347,50 +327,30 @@ QVariantList IconModule::previewIcons(const QString &themeName, int size, qreal
     return pixmaps;
 }
 
-QPixmap IconModule::getBestIcon(KIconTheme &theme, const QStringList &iconNames, int size, qreal dpr)
+void IconModule::loadPreviewIcons(const QString &themeName, int size, qreal dpr)
 {
-    QSvgRenderer renderer;
+    const QString cacheKey = previewCacheKey(themeName, size, dpr);
+    if (m_previewWatchers.contains(cacheKey)) {
+        return;
+    }
 
-    const int iconSize = size * dpr;
+    auto *watcher = new QFutureWatcher<QVector<QImage>>(this);
+    m_previewWatchers.insert(cacheKey, watcher);
 
-    // not using initializer list as we want to unwrap inherits()
-    const QStringList themes = QStringList() << theme.internalName() << theme.inherits();
-    for (const QString &themeName : themes) {
-        KIconTheme theme(themeName);
-
-        for (const QString &iconName : iconNames) {
-            QString path = theme.iconPath(QStringLiteral("%1.png").arg(iconName), iconSize, KIconLoader::MatchBest);
-            if (!path.isEmpty()) {
-                QPixmap pixmap(path);
-                pixmap.setDevicePixelRatio(dpr);
-                return pixmap;
-            }
-
-            // could not find the .png, try loading the .svg or .svgz
-            path = theme.iconPath(QStringLiteral("%1.svg").arg(iconName), iconSize, KIconLoader::MatchBest);
-            if (path.isEmpty()) {
-                path = theme.iconPath(QStringLiteral("%1.svgz").arg(iconName), iconSize, KIconLoader::MatchBest);
-            }
-
-            if (path.isEmpty()) {
-                continue;
-            }
-
-            if (!renderer.load(path)) {
-                continue;
-            }
-
-            QPixmap pixmap(iconSize, iconSize);
-            pixmap.setDevicePixelRatio(dpr);
-            pixmap.fill(QColor(Qt::transparent));
-            QPainter p(&pixmap);
-            p.setViewport(0, 0, size, size);
-            renderer.render(&p);
-            return pixmap;
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, cacheKey, themeName] {
+        const QVector<QImage> previews = watcher->result();
+        for (int i = 0; i < previews.count(); ++i) {
+            // Inserting a pixmap even if null so we know whether we searched for it already
+            QPixmapCache::insert(cacheKey + QLatin1Char('@') + QString::number(i), QPixmap::fromImage(previews.at(i)));
         }
-    }
 
-    return QPixmap();
+        m_previewWatchers.remove(cacheKey);
+        watcher->deleteLater();
+
+        Q_EMIT previewIconsLoaded(themeName);
+    });
+
+    watcher->setFuture(PreviewCache::previews(themeName, size, dpr));
 }
 
 int IconModule::pluginIndex(const QString &themeName) const
@@ -16,7 +16,10 @@
 #include <KQuickAddons/ManagedConfigModule>
 
 #include <QCache>
+#include <QHash>
+#include <QImage>
 #include <QScopedPointer>
+#include <QVector>
 
 class KIconTheme;
 class IconsSettings;
@@ -25,6 +28,9 @@ class IconsData;
 class QQuickItem;
 class QTemporaryFile;
 
+template<typename T>
+class QFutureWatcher;
+
 namespace KIO
 {
 class FileCopyJob;
@@ -75,7 +81,8 @@ public:
     Q_INVOKABLE int pluginIndex(const QString &pluginName) const;
 
     // QML doesn't understand QList<QPixmap>, hence wrapped in a QVariantList
-    Q_INVOKABLE QVariantList previewIcons(const QString &themeName, int size, qreal dpr, int limit = -1);
+    // undefined while the previews are being loaded, previewIconsLoaded is emitted once they are
+    Q_INVOKABLE QVariant previewIcons(const QString &themeName, int size, qreal dpr, int limit = -1);
 
 Q_SIGNALS:
     void downloadingFileChanged();
@@ -86,6 +93,8 @@ Q_SIGNALS:
     void showProgress(const QString &message);
     void hideProgress();
 
+    void previewIconsLoaded(const QString &themeName);
+
 private:
     bool isSaveNeeded() const override;
 
@@ -95,7 +104,7 @@ private:
     bool installThemes(const QStringList &themes, const QString &archiveName);
     void installThemeFile(const QString &path);
 
-    static QPixmap getBestIcon(KIconTheme &theme, const QStringList &iconNames, int size, qreal dpr);
+    void loadPreviewIcons(const QString &themeName, int size, qreal dpr);
 
     IconsData *m_data;
     IconsModel *m_model;
@@ -103,6 +112,8 @@ private:
 
     mutable QCache<QString, KIconTheme> m_kiconThemeCache;
 
+    QHash<QString, QFutureWatcher<QVector<QImage>> *> m_previewWatchers;
+
     QScopedPointer<QTemporaryFile> m_tempInstallFile;
     QPointer<KIO::FileCopyJob> m_tempCopyJob;
 };
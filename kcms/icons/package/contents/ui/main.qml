@@ -100,8 +100,26 @@ KCM.GridViewKCM {
                 readonly property int columns: 3
                 readonly property int rows: 2
 
+                // previews are loaded in a thread, ask again once they are ready
+                property bool previewsPending: false
+                property int previewLimit: -1
+
                 function loadPreviews(limit) {
-                    previews = kcm.previewIcons(model.themeName, Math.min(thumbFlow.iconWidth, thumbFlow.iconHeight), Screen.devicePixelRatio, limit);
+                    previewLimit = limit;
+                    const icons = kcm.previewIcons(model.themeName, Math.min(thumbFlow.iconWidth, thumbFlow.iconHeight), Screen.devicePixelRatio, limit);
+                    previewsPending = typeof icons === "undefined";
+                    if (!previewsPending) {
+                        previews = icons;
+                    }
+                }
+
+                Connections {
+                    target: kcm
+                    function onPreviewIconsLoaded(themeName) {
+                        if (thumbFlow.previewsPending && themeName === model.themeName) {
+                            thumbFlow.loadPreviews(thumbFlow.previewLimit);
+                        }
+                    }
                 }
 
                 width: parent.width
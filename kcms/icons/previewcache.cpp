@@ -0,0 +1,275 @@
+/*
+    SPDX-FileCopyrightText: 2018 Kai Uwe Broulik <kde@privat.broulik.de>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "previewcache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QFuture>
+#include <QPainter>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QSvgRenderer>
+#include <QUrl>
+#include <QtConcurrentRun>
+
+#include <KIconLoader>
+#include <KIconTheme>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+// bump whenever the way previews are rendered or stored changes
+const QString s_cacheVersion = QStringLiteral("1");
+
+const QVector<QStringList> &previewIconNames()
+{
+    static const QVector<QStringList> s_previewIcons{
+        {QStringLiteral("system-run"), QStringLiteral("exec")},
+        {QStringLiteral("folder")},
+        {QStringLiteral("document"), QStringLiteral("text-x-generic")},
+        {QStringLiteral("user-trash"), QStringLiteral("user-trash-empty")},
+        {QStringLiteral("help-browser"), QStringLiteral("system-help"), QStringLiteral("help-about"), QStringLiteral("help-contents")},
+        {QStringLiteral("preferences-system"), QStringLiteral("systemsettings"), QStringLiteral("configure")},
+
+        {QStringLiteral("text-html")},
+        {QStringLiteral("image-x-generic"), QStringLiteral("image-png"), QStringLiteral("image-jpeg")},
+        {QStringLiteral("video-x-generic"), QStringLiteral("video-x-theora+ogg"), QStringLiteral("video-mp4")},
+        {QStringLiteral("x-office-document")},
+        {QStringLiteral("x-office-spreadsheet")},
+        {QStringLiteral("x-office-presentation"), QStringLiteral("application-presentation")},
+
+        {QStringLiteral("user-home")},
+        {QStringLiteral("user-desktop"), QStringLiteral("desktop")},
+        {QStringLiteral("folder-image"), QStringLiteral("folder-images"), QStringLiteral("folder-pictures"), QStringLiteral("folder-picture")},
+        {QStringLiteral("folder-documents")},
+        {QStringLiteral("folder-download"), QStringLiteral("folder-downloads")},
+        {QStringLiteral("folder-video"), QStringLiteral("folder-videos")}};
+
+    return s_previewIcons;
+}
+
+QString cacheFolder()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/kcm_icons/previews/");
+}
+
+QString cacheFilePrefix(const QString &themeName)
+{
+    return QString::fromLatin1(QUrl::toPercentEncoding(themeName)) + QLatin1Char('@');
+}
+
+QString cacheFileName(const QString &themeName, int size, qreal dpr)
+{
+    return cacheFolder() + cacheFilePrefix(themeName) + QString::number(size) + QLatin1Char('@') + QString::number(dpr, 'f', 1) + QStringLiteral(".png");
+}
+
+// Installing, updating or removing a theme replaces files in its folders, previews also fall back to the inherited themes
+QString themeTimeStamp(const QStringList &themeNames)
+{
+    qint64 timeStamp = 0;
+    for (const QString &themeName : themeNames) {
+        QStringList folders =
+            QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, QStringLiteral("icons/") + themeName, QStandardPaths::LocateDirectory);
+        folders << QDir::homePath() + QStringLiteral("/.icons/") + themeName;
+
+        for (const QString &folder : qAsConst(folders)) {
+            for (const QFileInfo &info : {QFileInfo(folder), QFileInfo(folder + QStringLiteral("/index.theme"))}) {
+                if (info.exists()) {
+                    timeStamp = qMax(timeStamp, info.lastModified().toMSecsSinceEpoch());
+                }
+            }
+        }
+    }
+
+    return QString::number(timeStamp);
+}
+
+QImage bestIcon(const QStringList &themeNames, std::vector<std::unique_ptr<KIconTheme>> &themes, const QStringList &iconNames, int size, qreal dpr)
+{
+    QSvgRenderer renderer;
+
+    const int iconSize = size * dpr;
+
+    for (int i = 0; i < themeNames.count(); ++i) {
+        // created on-demand as it is quite expensive to do
+        if (!themes[i]) {
+            themes[i].reset(new KIconTheme(themeNames.at(i)));
+        }
+        const KIconTheme &theme = *themes[i];
+
+        for (const QString &iconName : iconNames) {
+            QString path = theme.iconPath(QStringLiteral("%1.png").arg(iconName), iconSize, KIconLoader::MatchBest);
+            if (!path.isEmpty()) {
+                QImage image(path);
+                image.setDevicePixelRatio(dpr);
+                return image;
+            }
+
+            // could not find the .png, try loading the .svg or .svgz
+            path = theme.iconPath(QStringLiteral("%1.svg").arg(iconName), iconSize, KIconLoader::MatchBest);
+            if (path.isEmpty()) {
+                path = theme.iconPath(QStringLiteral("%1.svgz").arg(iconName), iconSize, KIconLoader::MatchBest);
+            }
+
+            if (path.isEmpty()) {
+                continue;
+            }
+
+            if (!renderer.load(path)) {
+                continue;
+            }
+
+            QImage image(iconSize, iconSize, QImage::Format_ARGB32_Premultiplied);
+            image.setDevicePixelRatio(dpr);
+            image.fill(Qt::transparent);
+            QPainter p(&image);
+            p.setViewport(0, 0, size, size);
+            renderer.render(&p);
+            return image;
+        }
+    }
+
+    return QImage();
+}
+
+QVector<QImage> render(const QStringList &themeNames, int size, qreal dpr)
+{
+    const QVector<QStringList> &iconNames = previewIconNames();
+
+    std::vector<std::unique_ptr<KIconTheme>> themes(themeNames.count());
+
+    QVector<QImage> previews;
+    previews.reserve(iconNames.count());
+    for (const QStringList &names : iconNames) {
+        previews << bestIcon(themeNames, themes, names, size, dpr);
+    }
+
+    return previews;
+}
+
+// The previews are stored side by side in one image, their sizes and the theme time stamp in its text fields
+QVector<QImage> load(const QString &fileName, const QString &timeStamp, qreal dpr)
+{
+    const QImage atlas(fileName);
+    if (atlas.isNull() || atlas.text(QStringLiteral("Version")) != s_cacheVersion || atlas.text(QStringLiteral("TimeStamp")) != timeStamp) {
+        return {};
+    }
+
+    const QStringList sizes = atlas.text(QStringLiteral("Sizes")).split(QLatin1Char(','));
+    if (sizes.count() != previewIconNames().count()) {
+        return {};
+    }
+
+    const int cellWidth = atlas.width() / sizes.count();
+
+    QVector<QImage> previews;
+    previews.reserve(sizes.count());
+
+    for (int slot = 0; slot < sizes.count(); ++slot) {
+        const QStringList size = sizes.at(slot).split(QLatin1Char('x'));
+        const int width = size.value(0).toInt();
+        const int height = size.value(1).toInt();
+
+        if (width <= 0 || height <= 0) {
+            previews << QImage();
+            continue;
+        }
+        if (width > cellWidth || height > atlas.height()) {
+            return {};
+        }
+
+        QImage preview = atlas.copy(slot * cellWidth, 0, width, height);
+        preview.setDevicePixelRatio(dpr);
+        previews << preview;
+    }
+
+    return previews;
+}
+
+void save(const QString &fileName, const QString &timeStamp, const QVector<QImage> &previews)
+{
+    QStringList sizes;
+    int cellWidth = 1;
+    int cellHeight = 1;
+
+    for (const QImage &preview : previews) {
+        sizes << QString::number(preview.width()) + QLatin1Char('x') + QString::number(preview.height());
+        cellWidth = qMax(cellWidth, preview.width());
+        cellHeight = qMax(cellHeight, preview.height());
+    }
+
+    QImage atlas(cellWidth * previews.count(), cellHeight, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+
+    QPainter p(&atlas);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    for (int slot = 0; slot < previews.count(); ++slot) {
+        if (previews.at(slot).isNull()) {
+            continue;
+        }
+        // Draw in device pixels
+        QImage preview = previews.at(slot);
+        preview.setDevicePixelRatio(1);
+        p.drawImage(slot * cellWidth, 0, preview);
+    }
+    p.end();
+
+    atlas.setText(QStringLiteral("Version"), s_cacheVersion);
+    atlas.setText(QStringLiteral("TimeStamp"), timeStamp);
+    atlas.setText(QStringLiteral("Sizes"), sizes.join(QLatin1Char(',')));
+
+    QDir().mkpath(cacheFolder());
+
+    QSaveFile file(fileName);
+    if (file.open(QIODevice::WriteOnly) && atlas.save(&file, "PNG")) {
+        file.commit();
+    }
+}
+}
+
+namespace PreviewCache
+{
+int previewCount()
+{
+    return previewIconNames().count();
+}
+
+QFuture<QVector<QImage>> previews(const QString &themeName, int size, qreal dpr)
+{
+    // KIconTheme instances are not meant to be shared among threads, every job creates its own
+    return QtConcurrent::run([themeName, size, dpr]() {
+        // not using initializer list as we want to unwrap inherits()
+        const KIconTheme theme(themeName);
+        const QStringList themeNames = QStringList() << theme.internalName() << theme.inherits();
+
+        const QString fileName = cacheFileName(themeName, size, dpr);
+        const QString timeStamp = themeTimeStamp(themeNames);
+
+        QVector<QImage> previews = load(fileName, timeStamp, dpr);
+        if (previews.isEmpty()) {
+            previews = render(themeNames, size, dpr);
+            save(fileName, timeStamp, previews);
+        }
+
+        return previews;
+    });
+}
+
+void remove(const QString &themeName)
+{
+    QDir folder(cacheFolder());
+    const QStringList files = folder.entryList({cacheFilePrefix(themeName) + QLatin1Char('*')}, QDir::Files);
+    for (const QString &file : files) {
+        folder.remove(file);
+    }
+}
+}
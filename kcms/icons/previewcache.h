@@ -0,0 +1,42 @@
+/*
+    SPDX-FileCopyrightText: 2018 Kai Uwe Broulik <kde@privat.broulik.de>
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFuture>
+#include <QImage>
+#include <QString>
+#include <QVector>
+
+/**
+ * Preview icons of icon themes, as shown in the theme grid.
+ *
+ * Rendering them means looking up and rasterizing a dozen of icons per theme, walking
+ * the inherited themes, which adds up quickly with many themes installed. Previews are
+ * therefore stored on disk, one image atlas per theme, size and device pixel ratio, and
+ * trusted until the folders of the theme or the themes it inherits are modified. Previews are
+ * loaded and rendered off the GUI thread, one job per theme.
+ */
+namespace PreviewCache
+{
+/**
+ * The number of preview icons of every theme
+ */
+int previewCount();
+
+/**
+ * Loads the preview icons of the theme in a worker thread, rendering and storing them if needed.
+ *
+ * The result lists them in a fixed order, a null image where the theme has no suitable icon.
+ */
+QFuture<QVector<QImage>> previews(const QString &themeName, int size, qreal dpr);
+
+/**
+ * Removes the stored previews of a theme, to be called when it is uninstalled
+ */
+void remove(const QString &themeName);
+}
@@ -330,6 +330,29 @@ Folder::Flat Folder::flatten() const
     return rv;
 }
 
+Folder::Flat Folder::flatten(const QSet<QString> &dirs) const
+{
+    FamilyCont::ConstIterator fam = m_fonts.begin(), famEnd = m_fonts.end();
+    Flat rv;
+
+    for (; fam != famEnd; ++fam) {
+        StyleCont::ConstIterator style((*fam).styles().begin()), styleEnd((*fam).styles().end());
+
+        for (; style != styleEnd; ++style) {
+            FileCont::ConstIterator file((*style).files().begin()), fileEnd((*style).files().end());
+
+            for (; file != fileEnd; ++file) {
+                // Disabled fonts are not known to fontconfig, so always consider these
+                if (dirs.contains(Misc::getDir((*file).path())) || Misc::isHidden(Misc::getFile((*file).path()))) {
+                    rv.insert(FlatFont(*fam, *style, *file));
+                }
+            }
+        }
+    }
+
+    return rv;
+}
+
 Families Folder::Flat::build(bool system) const
 {
     ConstIterator it(begin()), e(end());
@@ -92,6 +92,7 @@ public:
     }
     void configure(bool force = false);
     Flat flatten() const;
+    Flat flatten(const QSet<QString> &dirs) const;
     const FamilyCont &fonts() const
     {
         return m_fonts;
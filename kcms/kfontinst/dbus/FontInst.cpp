@@ -16,9 +16,13 @@
 #include <KAuth/ExecuteJob>
 #include <KAuth/HelperSupport>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QHash>
 #include <QTimer>
 #include <fontconfig/fontconfig.h>
 #include <kio/global.h>
+#include <qplatformdefs.h>
 #include <signal.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -39,6 +43,24 @@ static const int constSystemReconfigured = -1;
 static const int constConnectionsTimeout = 30 * 1000;
 static const int constFontListTimeout = 10 * 1000;
 
+// Fonts found within each of fontconfig's font folders, keyed on folder path. Only folders whose
+// modification time has changed need to be re-read from fontconfig when the font list is updated.
+struct FontDir {
+    qint64 timeStamp = 0;
+    FontInst::EFolder folder = FontInst::FOLDER_SYS;
+    QList<Folder::FlatFont> fonts;
+};
+
+static QHash<QString, FontDir> theFontDirs;
+
+static qint64 dirTimeStamp(const QString &dir)
+{
+    QT_STATBUF info;
+
+    // Use nanosecond resolution, so that several changes within the same second are not missed
+    return 0 == QT_STAT(QFile::encodeName(dir), &info) ? qint64(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec : 0;
+}
+
 typedef void (*SignalHandler)(int);
 
 static void registerSignalHandler(SignalHandler handler)
@@ -562,12 +584,14 @@ void FontInst::updateFontList(bool emitChanges)
             }
         }
 
+        // qDebug() << "Determine which font folders have changed";
+        QSet<QString> changedDirs = updateFontDirs();
         Folder::Flat old[FOLDER_COUNT];
 
         if (emitChanges) {
-            // qDebug() << "Flatten existing font lists";
+            // qDebug() << "Flatten existing fonts of changed folders";
             for (int i = 0; i < (isSystem ? 1 : FOLDER_COUNT); ++i) {
-                old[i] = theFolders[i].flatten();
+                old[i] = theFolders[i].flatten(changedDirs);
             }
         }
 
@@ -577,73 +601,36 @@ void FontInst::updateFontList(bool emitChanges)
             theFolders[i].clearFonts();
         }
 
-        // qDebug() << "update list of fonts";
-
-        FcPattern *pat = FcPatternCreate();
-        FcObjectSet *os = FcObjectSetBuild(FC_FILE,
-                                           FC_FAMILY,
-                                           FC_FAMILYLANG,
-                                           FC_WEIGHT,
-                                           FC_LANG,
-                                           FC_CHARSET,
-                                           FC_SCALABLE,
-#ifndef KFI_FC_NO_WIDTHS
-                                           FC_WIDTH,
-#endif
-                                           FC_SLANT,
-                                           FC_INDEX,
-                                           FC_FOUNDRY,
-                                           (void *)nullptr);
-
-        FcFontSet *list = FcFontList(nullptr, pat, os);
-
-        FcPatternDestroy(pat);
-        FcObjectSetDestroy(os);
-
         theFolders[FOLDER_SYS].loadDisabled();
         if (!isSystem) {
             theFolders[FOLDER_USER].loadDisabled();
         }
 
-        if (list) {
-            QString home(Misc::dirSyntax(QDir::homePath()));
-
-            for (int i = 0; i < list->nfont; i++) {
-                QString fileName(Misc::fileSyntax(FC::getFcString(list->fonts[i], FC_FILE)));
+        // qDebug() << "update list of fonts";
 
-                if (!fileName.isEmpty() && Misc::fExists(fileName)) // && 0!=fileName.indexOf(constDefomaLocation))
-                {
-                    QString family, foundry;
-                    quint32 styleVal;
-                    int index;
-                    qulonglong writingSystems(WritingSystems::instance()->get(list->fonts[i]));
-                    FcBool scalable = FcFalse;
+        QHash<QString, FontDir>::ConstIterator dir(theFontDirs.constBegin()), dirEnd(theFontDirs.constEnd());
 
-                    if (FcResultMatch != FcPatternGetBool(list->fonts[i], FC_SCALABLE, 0, &scalable)) {
-                        scalable = FcFalse;
-                    }
+        for (; dir != dirEnd; ++dir) {
+            Folder &folder = theFolders[(*dir).folder];
+            QList<Folder::FlatFont>::ConstIterator it((*dir).fonts.constBegin()), end((*dir).fonts.constEnd());
 
-                    FC::getDetails(list->fonts[i], family, styleVal, index, foundry);
-                    FamilyCont::ConstIterator fam = theFolders[isSystem || 0 != fileName.indexOf(home) ? FOLDER_SYS : FOLDER_USER].addFont(Family(family));
-                    StyleCont::ConstIterator style = (*fam).add(Style(styleVal));
-                    FileCont::ConstIterator file = (*style).add(File(fileName, foundry, index));
-                    Q_UNUSED(file);
+            for (; it != end; ++it) {
+                FamilyCont::ConstIterator fam = folder.addFont(Family((*it).family));
+                StyleCont::ConstIterator style = (*fam).add(Style((*it).styleInfo));
 
-                    (*style).setWritingSystems((*style).writingSystems() | writingSystems);
-                    if (scalable) {
-                        (*style).setScalable();
-                    }
+                (*style).add((*it).file);
+                (*style).setWritingSystems((*style).writingSystems() | (*it).writingSystems);
+                if ((*it).scalable) {
+                    (*style).setScalable();
                 }
             }
-
-            FcFontSetDestroy(list);
         }
 
         if (emitChanges) {
             // qDebug() << "Look for differences";
             for (int i = 0; i < (isSystem ? 1 : FOLDER_COUNT); ++i) {
                 // qDebug() << "Flatten, and take copies...";
-                Folder::Flat newList = theFolders[i].flatten(), onlyNew = newList;
+                Folder::Flat newList = theFolders[i].flatten(changedDirs), onlyNew = newList;
 
                 // qDebug() << "Determine differences...";
                 onlyNew.subtract(old[i]);
@@ -666,6 +653,84 @@ void FontInst::updateFontList(bool emitChanges)
     }
 }
 
+QSet<QString> FontInst::updateFontDirs()
+{
+    QSet<QString> changed, current;
+    QString home(Misc::dirSyntax(QDir::homePath()));
+    FcStrList *list = FcConfigGetFontDirs(nullptr);
+    FcChar8 *fcDir;
+
+    while ((fcDir = FcStrListNext(list))) {
+        QString dir(Misc::dirSyntax(QFile::decodeName((const char *)fcDir)));
+        qint64 timeStamp(dirTimeStamp(dir));
+        QHash<QString, FontDir>::Iterator cached(theFontDirs.find(dir));
+
+        current.insert(dir);
+        if (theFontDirs.end() != cached && (*cached).timeStamp == timeStamp) {
+            continue;
+        }
+
+        // qDebug() << "Rescan" << dir;
+        FontDir &fontDir = theFontDirs[dir];
+
+        fontDir.timeStamp = timeStamp;
+        fontDir.folder = isSystem || 0 != dir.indexOf(home) ? FOLDER_SYS : FOLDER_USER;
+        fontDir.fonts.clear();
+        changed.insert(dir);
+
+        // Only read the fonts held directly within this folder - sub-folders are listed by FcConfigGetFontDirs()
+        FcCache *cache = FcDirCacheRead(fcDir, FcFalse, nullptr);
+
+        if (!cache) {
+            continue;
+        }
+
+        FcFontSet *set = FcCacheCopySet(cache);
+
+        if (set) {
+            for (int i = 0; i < set->nfont; i++) {
+                QString fileName(Misc::fileSyntax(FC::getFcString(set->fonts[i], FC_FILE)));
+
+                if (!fileName.isEmpty() && Misc::fExists(fileName)) {
+                    QString family, foundry;
+                    quint32 styleVal;
+                    int index;
+                    FcBool scalable = FcFalse;
+
+                    if (FcResultMatch != FcPatternGetBool(set->fonts[i], FC_SCALABLE, 0, &scalable)) {
+                        scalable = FcFalse;
+                    }
+
+                    FC::getDetails(set->fonts[i], family, styleVal, index, foundry);
+                    fontDir.fonts.append(Folder::FlatFont(Family(family),
+                                                          Style(styleVal, scalable, WritingSystems::instance()->get(set->fonts[i])),
+                                                          File(fileName, foundry, index)));
+                }
+            }
+
+            FcFontSetDestroy(set);
+        }
+
+        FcDirCacheUnload(cache);
+    }
+
+    FcStrListDone(list);
+
+    // Forget about any folders that fontconfig no longer knows of, their fonts have gone too...
+    QHash<QString, FontDir>::Iterator it(theFontDirs.begin());
+
+    while (it != theFontDirs.end()) {
+        if (current.contains(it.key())) {
+            ++it;
+        } else {
+            changed.insert(it.key());
+            it = theFontDirs.erase(it);
+        }
+    }
+
+    return changed;
+}
+
 void FontInst::toggle(bool enable, const QString &family, quint32 style, bool inSystem, int pid, bool checkConfig)
 {
     m_connections.insert(pid);
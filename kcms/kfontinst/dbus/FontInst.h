@@ -105,6 +105,7 @@ private Q_SLOTS:
 
 private:
     void updateFontList(bool emitChanges = true);
+    QSet<QString> updateFontDirs();
     void toggle(bool enable, const QString &family, quint32 style, bool inSystem, int pid, bool checkConfig);
     void addModifedSysFolders(const Family &family);
     void checkConnections();
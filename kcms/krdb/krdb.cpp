@@ -1,7 +1,7 @@
 /*
     KRDB - puts current KDE color scheme into preprocessor statements
-    cats specially written application default files and uses xrdb -merge to
-    write to RESOURCE_MANAGER. Thus it gives a  simple way to make non-KDE
+    cats specially written application default files and merges them into
+    RESOURCE_MANAGER, like xrdb -merge does. Thus it gives a  simple way to make non-KDE
     applications fit in with the desktop
 
     SPDX-FileCopyrightText: 1998 Mark Donohoe
@@ -29,6 +29,8 @@
 #include <QBuffer>
 #include <QDir>
 #include <QFontDatabase>
+#include <QMap>
+#include <QScopedPointer>
 #include <QSettings>
 
 #include <QByteArray>
@@ -50,6 +52,7 @@
 #include <updatelaunchenvjob.h>
 
 #include "krdb.h"
+#include "krdb_debug.h"
 #if HAVE_X11
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #include <private/qtx11extras_p.h>
@@ -57,7 +60,10 @@
 #include <QX11Info>
 #endif
 #include <X11/Xlib.h>
+#include <xcb/xcb.h>
 #endif
+
+#include <algorithm>
 inline const char *gtkEnvVar(int version)
 {
     return 2 == version ? "GTK2_RC_FILES" : "GTK_RC_FILES";
@@ -225,17 +231,221 @@ static void addColorDef(QString &s, const char *n, const QColor &col)
 
 // -----------------------------------------------------------------------------
 
-static void copyFile(QFile &tmp, QString const &filename, bool)
+static QByteArray readFile(const QString &filename)
 {
     QFile f(filename);
     if (f.open(QIODevice::ReadOnly)) {
-        QByteArray buf(8192, ' ');
-        while (!f.atEnd()) {
-            int read = f.read(buf.data(), buf.size());
-            if (read > 0)
-                tmp.write(buf.data(), read);
+        return f.readAll();
+    }
+    return QByteArray();
+}
+
+// -----------------------------------------------------------------------------
+
+// X resources, by name, like xrdb keeps them
+using XResources = QMap<QByteArray, QByteArray>;
+
+// xrdb runs its input through cpp, which user files may rely on for #include or #define,
+// or for dropping C style comments
+static bool needsPreprocessor(const QByteArray &data)
+{
+    if (data.contains("/*")) {
+        return true;
+    }
+
+    const QList<QByteArray> lines = data.split('\n');
+    return std::any_of(lines.cbegin(), lines.cend(), [](const QByteArray &line) {
+        return line.trimmed().startsWith('#');
+    });
+}
+
+static void parseResources(const QByteArray &data, XResources &resources)
+{
+    const QList<QByteArray> lines = data.split('\n');
+
+    QByteArray entry;
+    for (const QByteArray &line : lines) {
+        entry += line;
+
+        // An odd number of trailing backslashes continues the entry on the next line
+        int backslashes = 0;
+        for (int i = line.size() - 1; i >= 0 && line.at(i) == '\\'; --i) {
+            ++backslashes;
         }
+        if (backslashes % 2) {
+            entry.chop(1);
+            continue;
+        }
+
+        const QByteArray trimmed = entry.trimmed();
+        entry.clear();
+
+        if (trimmed.isEmpty() || trimmed.startsWith('!')) {
+            continue;
+        }
+
+        const int colon = trimmed.indexOf(':');
+        const QByteArray name = trimmed.left(colon).trimmed();
+        if (colon == -1 || name.isEmpty()) {
+            continue;
+        }
+
+        resources.insert(name, trimmed.mid(colon + 1).trimmed());
+    }
+}
+
+static QByteArray serializeResources(const XResources &resources)
+{
+    QByteArray data;
+    for (auto it = resources.cbegin(); it != resources.cend(); ++it) {
+        data += it.key() + ":\t" + it.value() + '\n';
     }
+    return data;
+}
+
+// -----------------------------------------------------------------------------
+
+// Used when the resources need to be preprocessed
+static void mergeResourcesWithXrdb(const QByteArray &data, bool resetDpi)
+{
+    if (resetDpi) {
+        KProcess queryProc;
+        queryProc << QStringLiteral("xrdb") << QStringLiteral("-query");
+        queryProc.setOutputChannelMode(KProcess::OnlyStdoutChannel);
+        queryProc.start();
+        if (queryProc.waitForFinished()) {
+            QByteArray db = queryProc.readAllStandardOutput();
+            int idx1 = 0;
+            while (idx1 < db.size()) {
+                int idx2 = db.indexOf('\n', idx1);
+                if (idx2 == -1) {
+                    idx2 = db.size() - 1;
+                }
+                const auto entry = QByteArray::fromRawData(db.constData() + idx1, idx2 - idx1 + 1);
+                if (entry.startsWith("Xft.dpi:")) {
+                    db.remove(idx1, entry.size());
+                } else {
+                    idx1 = idx2 + 1;
+                }
+            }
+
+            KProcess loadProc;
+            loadProc << QStringLiteral("xrdb") << QStringLiteral("-quiet") << QStringLiteral("-load") << QStringLiteral("-nocpp");
+            loadProc.start();
+            if (loadProc.waitForStarted()) {
+                loadProc.write(db);
+                loadProc.closeWriteChannel();
+                loadProc.waitForFinished();
+            }
+        }
+    }
+
+    QTemporaryFile tmpFile;
+    if (!tmpFile.open()) {
+        qCWarning(KRDB_DEBUG) << "Couldn't open temp file";
+        return;
+    }
+    tmpFile.write(data);
+    tmpFile.flush();
+
+    KProcess proc;
+#ifndef NDEBUG
+    proc << QStringLiteral("xrdb") << QStringLiteral("-merge") << tmpFile.fileName();
+#else
+    proc << "xrdb"
+         << "-quiet"
+         << "-merge" << tmpFile.fileName();
+#endif
+    proc.execute();
+}
+
+#if HAVE_X11
+static QByteArray readResourceManager(xcb_connection_t *c, xcb_window_t root)
+{
+    QByteArray data;
+
+    uint32_t offset = 0;
+    forever {
+        // offset and length are in 32 bit units
+        const xcb_get_property_cookie_t cookie = xcb_get_property(c, false, root, XCB_ATOM_RESOURCE_MANAGER, XCB_ATOM_STRING, offset, 1 << 16);
+        QScopedPointer<xcb_get_property_reply_t, QScopedPointerPodDeleter> reply(xcb_get_property_reply(c, cookie, nullptr));
+        if (!reply || reply->type != XCB_ATOM_STRING || reply->format != 8) {
+            break;
+        }
+
+        const int length = xcb_get_property_value_length(reply.data());
+        data.append(static_cast<const char *>(xcb_get_property_value(reply.data())), length);
+
+        if (reply->bytes_after == 0 || length == 0) {
+            break;
+        }
+        offset += length / 4;
+    }
+
+    return data;
+}
+
+static void writeResourceManager(xcb_connection_t *c, xcb_window_t root, const QByteArray &data)
+{
+    // The maximum request length is in 32 bit units, leave room for the request header
+    const int maxChunk = qMax<int>(xcb_get_maximum_request_length(c), 1024) * 4 - 32;
+
+    uint8_t mode = XCB_PROP_MODE_REPLACE;
+    int offset = 0;
+    do {
+        const int chunk = qMin(data.size() - offset, maxChunk);
+        xcb_change_property(c, mode, root, XCB_ATOM_RESOURCE_MANAGER, XCB_ATOM_STRING, 8, chunk, data.constData() + offset);
+        mode = XCB_PROP_MODE_APPEND;
+        offset += chunk;
+    } while (offset < data.size());
+
+    xcb_flush(c);
+}
+#endif
+
+// Does what xrdb -merge does, in process, and leaves RESOURCE_MANAGER alone when nothing changes
+static void mergeResources(const QByteArray &data, bool resetDpi)
+{
+#if HAVE_X11
+    if (needsPreprocessor(data)) {
+        mergeResourcesWithXrdb(data, resetDpi);
+        return;
+    }
+
+    int screenNumber = 0;
+    xcb_connection_t *c = xcb_connect(nullptr, &screenNumber);
+    if (xcb_connection_has_error(c)) {
+        qCWarning(KRDB_DEBUG) << "Couldn't connect to the X server";
+        xcb_disconnect(c);
+        return;
+    }
+
+    xcb_screen_iterator_t screens = xcb_setup_roots_iterator(xcb_get_setup(c));
+    for (int i = 0; i < screenNumber && screens.rem; ++i) {
+        xcb_screen_next(&screens);
+    }
+
+    if (screens.rem) {
+        const xcb_window_t root = screens.data->root;
+
+        XResources current;
+        parseResources(readResourceManager(c, root), current);
+
+        XResources merged = current;
+        if (resetDpi) {
+            merged.remove("Xft.dpi");
+        }
+        parseResources(data, merged);
+
+        if (merged != current) {
+            writeResourceManager(c, root, serializeResources(merged));
+        }
+    }
+
+    xcb_disconnect(c);
+#else
+    mergeResourcesWithXrdb(data, resetDpi);
+#endif
 }
 
 // -----------------------------------------------------------------------------
@@ -246,15 +456,10 @@ static void createGtkrc(const QPalette &cg, bool exportGtkTheme, const QString &
     // lukas: why does it create in ~/.kde/share/config ???
     // pfeiffer: so that we don't overwrite the user's gtkrc.
     // it is found via the GTK_RC_FILES environment variable.
-    QSaveFile saveFile(writableGtkrc(version));
-    if (!saveFile.open(QIODevice::WriteOnly))
-        return;
+    const QString fileName = writableGtkrc(version);
 
-    QTextStream t(&saveFile);
-    t << i18n(
-        "# created by KDE Plasma, %1\n"
-        "#\n",
-        QDateTime::currentDateTime().toString());
+    QString contents;
+    QTextStream t(&contents);
 
     if (2 == version) { // we should maybe check for MacOS settings here
         using Qt::endl;
@@ -273,8 +478,8 @@ static void createGtkrc(const QPalette &cg, bool exportGtkTheme, const QString &
         bool exist_gtkrc = false;
         QByteArray gtkrc = getenv(gtkEnvVar(version));
         QStringList listGtkrc = QFile::decodeName(gtkrc).split(QLatin1Char(':'));
-        if (listGtkrc.contains(saveFile.fileName()))
-            listGtkrc.removeAll(saveFile.fileName());
+        if (listGtkrc.contains(fileName))
+            listGtkrc.removeAll(fileName);
         listGtkrc.append(QDir::homePath() + userGtkrc(version));
         listGtkrc.append(QDir::homePath() + "/.gtkrc-2.0-kde");
         listGtkrc.append(QDir::homePath() + "/.gtkrc-2.0-kde4");
@@ -313,6 +518,34 @@ static void createGtkrc(const QPalette &cg, bool exportGtkTheme, const QString &
         }
     }
 
+    t.flush();
+
+    // Only the time stamp in the header would change, don't touch the file then
+    QFile currentFile(fileName);
+    if (currentFile.open(QIODevice::ReadOnly)) {
+        const QString current = QString::fromUtf8(currentFile.readAll());
+        if (current.endsWith(contents)) {
+            const QStringList header = current.left(current.size() - contents.size()).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+            if (std::all_of(header.cbegin(), header.cend(), [](const QString &line) {
+                    return line.startsWith(QLatin1Char('#'));
+                })) {
+                return;
+            }
+        }
+    }
+
+    QSaveFile saveFile(fileName);
+    if (!saveFile.open(QIODevice::WriteOnly))
+        return;
+
+    QTextStream out(&saveFile);
+    out << i18n(
+        "# created by KDE Plasma, %1\n"
+        "#\n",
+        QDateTime::currentDateTime().toString());
+    out << contents;
+    out.flush();
+
     saveFile.commit();
 }
 
@@ -330,12 +563,6 @@ void runRdb(uint flags)
     KConfigGroup kglobals(kglobalcfg, "KDE");
     QPalette newPal = KColorScheme::createApplicationPalette(kglobalcfg);
 
-    QTemporaryFile tmpFile;
-    if (!tmpFile.open()) {
-        qDebug() << "Couldn't open temp file";
-        exit(0);
-    }
-
     KConfigGroup generalCfgGroup(kglobalcfg, "General");
 
     QString gtkTheme;
@@ -352,10 +579,13 @@ void runRdb(uint flags)
     QString xResources = homeDir + "/.Xresources";
 
     // very primitive support for ~/.Xresources by appending it
+    QByteArray resources;
     if (QFile::exists(xResources))
-        copyFile(tmpFile, xResources, true);
+        resources = readFile(xResources);
     else
-        copyFile(tmpFile, homeDir + "/.Xdefaults", true);
+        resources = readFile(homeDir + "/.Xdefaults");
+    if (!resources.isEmpty() && !resources.endsWith('\n'))
+        resources += '\n';
 
     // Export the Xcursor theme & size settings
     KConfigGroup mousecfg(KSharedConfig::openConfig(QStringLiteral("kcminputrc")), "Mouse");
@@ -369,6 +599,9 @@ void runRdb(uint flags)
     if (!size.isNull())
         contents += "Xcursor.size: " + size + '\n';
 
+    // Drop a DPI set by a previous run, when none is forced anymore
+    bool resetDpi = false;
+
     if (exportXftSettings) {
         contents += QLatin1String("Xft.antialias: ");
         if (generalCfgGroup.readEntry("XftAntialias", true))
@@ -409,53 +642,13 @@ void runRdb(uint flags)
         }
         if (dpi != 0)
             contents += "Xft.dpi: " + QString::number(dpi) + '\n';
-        else {
-            KProcess queryProc;
-            queryProc << QStringLiteral("xrdb") << QStringLiteral("-query");
-            queryProc.setOutputChannelMode(KProcess::OnlyStdoutChannel);
-            queryProc.start();
-            if (queryProc.waitForFinished()) {
-                QByteArray db = queryProc.readAllStandardOutput();
-                int idx1 = 0;
-                while (idx1 < db.size()) {
-                    int idx2 = db.indexOf('\n', idx1);
-                    if (idx2 == -1) {
-                        idx2 = db.size() - 1;
-                    }
-                    const auto entry = QByteArray::fromRawData(db.constData() + idx1, idx2 - idx1 + 1);
-                    if (entry.startsWith("Xft.dpi:")) {
-                        db.remove(idx1, entry.size());
-                    } else {
-                        idx1 = idx2 + 1;
-                    }
-                }
-
-                KProcess loadProc;
-                loadProc << QStringLiteral("xrdb") << QStringLiteral("-quiet") << QStringLiteral("-load") << QStringLiteral("-nocpp");
-                loadProc.start();
-                if (loadProc.waitForStarted()) {
-                    loadProc.write(db);
-                    loadProc.closeWriteChannel();
-                    loadProc.waitForFinished();
-                }
-            }
-        }
+        else
+            resetDpi = true;
     }
 
-    if (contents.length() > 0)
-        tmpFile.write(contents.toLatin1(), contents.length());
-
-    tmpFile.flush();
+    resources += contents.toLatin1();
 
-    KProcess proc;
-#ifndef NDEBUG
-    proc << QStringLiteral("xrdb") << QStringLiteral("-merge") << tmpFile.fileName();
-#else
-    proc << "xrdb"
-         << "-quiet"
-         << "-merge" << tmpFile.fileName();
-#endif
-    proc.execute();
+    mergeResources(resources, resetDpi);
 
     applyGtkStyles(1);
     applyGtkStyles(2);
@@ -0,0 +1,212 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "desktopentrycache.h"
+
+#include <KConfigGroup>
+#include <KDesktopFile>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QLocale>
+#include <QSaveFile>
+
+namespace
+{
+const quint32 s_cacheVersion = 2;
+
+QString cacheLocale()
+{
+    return QLocale().name() + QLatin1Char('|') + QString::fromLocal8Bit(qgetenv("LANGUAGE"));
+}
+}
+
+DesktopEntryCache::DesktopEntryCache(const QString &cacheFile)
+    : m_cacheFile(cacheFile)
+{
+}
+
+DesktopEntryCache::~DesktopEntryCache()
+{
+    save();
+}
+
+DesktopEntryCache::PathState DesktopEntryCache::currentPathState()
+{
+    PathState state;
+
+    const QStringList dirs = QString::fromLocal8Bit(qgetenv("PATH")).split(QDir::listSeparator(), Qt::SkipEmptyParts);
+    state.reserve(dirs.count());
+    for (const QString &dir : dirs) {
+        const QFileInfo info(dir);
+        state.append({dir, info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1});
+    }
+
+    return state;
+}
+
+// Installing or removing the program changes its directory, making it executable changes the program itself
+qint64 DesktopEntryCache::programState(const QString &program)
+{
+    const QFileInfo info(program);
+    const QFileInfo dirInfo(info.absolutePath());
+
+    qint64 state = dirInfo.exists() ? dirInfo.lastModified().toMSecsSinceEpoch() : -1;
+    if (info.exists()) {
+        state = qMax(state, info.metadataChangeTime().toMSecsSinceEpoch());
+    }
+    return state;
+}
+
+void DesktopEntryCache::refresh()
+{
+    load();
+
+    const PathState pathState = currentPathState();
+    if (pathState == m_pathState) {
+        return;
+    }
+
+    m_pathState = pathState;
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->usesPath) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_dirty = true;
+}
+
+DesktopEntryCache::Entry DesktopEntryCache::entry(const QString &path)
+{
+    if (!m_loaded) {
+        refresh();
+    }
+
+    const QFileInfo info(path);
+    const qint64 lastModified = info.lastModified().toMSecsSinceEpoch();
+    const qint64 size = info.size();
+
+    auto it = m_entries.constFind(path);
+    if (it != m_entries.constEnd() && it->lastModified == lastModified && it->size == size
+        && (it->tryExec.isEmpty() || programState(it->tryExec) == it->tryExecState)) {
+        return it->entry;
+    }
+
+    KDesktopFile file(path);
+
+    CachedEntry cached;
+    cached.lastModified = lastModified;
+    cached.size = size;
+    cached.entry.name = file.readName();
+    cached.entry.hidden = !file.tryExec();
+
+    const QString tryExec = file.desktopGroup().readPathEntry("TryExec", QString());
+    if (QDir::isAbsolutePath(tryExec)) {
+        cached.tryExec = tryExec;
+        cached.tryExecState = programState(tryExec);
+    } else {
+        cached.usesPath = !tryExec.isEmpty();
+    }
+
+    m_entries.insert(path, cached);
+    m_dirty = true;
+
+    return cached.entry;
+}
+
+void DesktopEntryCache::load()
+{
+    if (m_loaded) {
+        return;
+    }
+    m_loaded = true;
+
+    QFile file(m_cacheFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 version = 0;
+    QString locale;
+    stream >> version >> locale;
+    // Names are read translated
+    if (version != s_cacheVersion || locale != cacheLocale()) {
+        return;
+    }
+
+    qint32 pathDirs = 0;
+    stream >> pathDirs;
+    for (int i = 0; i < pathDirs && stream.status() == QDataStream::Ok; ++i) {
+        QString dir;
+        qint64 lastModified = 0;
+        stream >> dir >> lastModified;
+        m_pathState.append({dir, lastModified});
+    }
+
+    qint32 count = 0;
+    stream >> count;
+    for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        CachedEntry cached;
+        stream >> path >> cached.lastModified >> cached.size >> cached.entry.name >> cached.entry.hidden >> cached.usesPath >> cached.tryExec >> cached.tryExecState;
+        m_entries.insert(path, cached);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        m_pathState.clear();
+        m_entries.clear();
+    }
+}
+
+void DesktopEntryCache::save()
+{
+    if (!m_dirty) {
+        return;
+    }
+
+    // Forget about files that were deleted since
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (!QFileInfo::exists(it.key())) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    QDir().mkpath(QFileInfo(m_cacheFile).path());
+
+    QSaveFile file(m_cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    stream << s_cacheVersion << cacheLocale();
+
+    stream << qint32(m_pathState.count());
+    for (const auto &dir : qAsConst(m_pathState)) {
+        stream << dir.first << dir.second;
+    }
+
+    stream << qint32(m_entries.count());
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        stream << it.key() << it->lastModified << it->size << it->entry.name << it->entry.hidden << it->usesPath << it->tryExec << it->tryExecState;
+    }
+
+    if (file.commit()) {
+        m_dirty = false;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/**
+ * Remembers what listings need to know about desktop files, so that they do not
+ * have to be parsed again as long as they did not change.
+ *
+ * Entries are keyed by path and invalidated by modification time and size. Whether
+ * a TryExec program exists is also invalidated when a directory in $PATH changed,
+ * which is what installing or removing a program does, or for an absolute TryExec,
+ * when the program or the directory it is in changed.
+ */
+class DesktopEntryCache
+{
+public:
+    struct Entry {
+        QString name;
+        bool hidden = false;
+    };
+
+    explicit DesktopEntryCache(const QString &cacheFile);
+    ~DesktopEntryCache();
+
+    /**
+     * Looks at $PATH again, to be called before a listing
+     */
+    void refresh();
+
+    Entry entry(const QString &path);
+
+    /**
+     * Writes the cache out if anything changed
+     */
+    void save();
+
+private:
+    struct CachedEntry {
+        qint64 lastModified = 0;
+        qint64 size = 0;
+        Entry entry;
+        // Whether the result depends on the programs in $PATH
+        bool usesPath = false;
+        // An absolute TryExec, and its state when the entry was made
+        QString tryExec;
+        qint64 tryExecState = 0;
+    };
+
+    using PathState = QVector<QPair<QString, qint64>>;
+    static PathState currentPathState();
+    static qint64 programState(const QString &program);
+
+    void load();
+
+    QString m_cacheFile;
+    QHash<QString, CachedEntry> m_entries;
+    PathState m_pathState;
+    bool m_loaded = false;
+    bool m_dirty = false;
+};
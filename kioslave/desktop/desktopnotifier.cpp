@@ -12,8 +12,10 @@
 
 #include <kdirnotify.h>
 
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QStandardPaths>
 
 K_PLUGIN_CLASS_WITH_JSON(DesktopNotifier, "desktopnotifier.json")
@@ -30,11 +32,19 @@ DesktopNotifier::DesktopNotifier(QObject *parent, const QList<QVariant> &)
 
     connect(dirWatch, &KDirWatch::created, this, &DesktopNotifier::created);
     connect(dirWatch, &KDirWatch::dirty, this, &DesktopNotifier::dirty);
+
+    const QString desktopPath = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
+    m_snapshots.insert(desktopPath, snapshot(desktopPath));
 }
 
 void DesktopNotifier::watchDir(const QString &path)
 {
     dirWatch->addDir(path);
+
+    // Called for every listing, only the first one needs to be remembered
+    if (!m_snapshots.contains(path)) {
+        m_snapshots.insert(path, snapshot(path));
+    }
 }
 
 void DesktopNotifier::created(const QString &path)
@@ -46,33 +56,36 @@ void DesktopNotifier::created(const QString &path)
 
 void DesktopNotifier::dirty(const QString &path)
 {
-    Q_UNUSED(path)
-
     if (path.startsWith(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + '/' + "Trash/files")) {
-        QList<QUrl> trashUrls;
-
-        // Check for any .desktop file linking to trash:/ to update its icon
-        const auto desktopFiles = QDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).entryInfoList({QStringLiteral("*.desktop")});
-        for (const auto &fi : desktopFiles) {
-            KDesktopFile df(fi.absoluteFilePath());
-            if (df.hasLinkType() && df.readUrl() == QLatin1String("trash:/")) {
-                trashUrls << QUrl(QStringLiteral("desktop:/") + fi.fileName());
-            }
+        // Update the icon of the .desktop files linking to trash:/
+        if (!m_trashLinksScanned) {
+            scanTrashLinks();
         }
 
-        if (!trashUrls.isEmpty()) {
+        if (!m_trashLinks.isEmpty()) {
+            QList<QUrl> trashUrls;
+            for (const QString &link : qAsConst(m_trashLinks)) {
+                trashUrls << desktopUrl(link);
+            }
             org::kde::KDirNotify::emitFilesChanged(trashUrls);
         }
     } else if (path == QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + QStringLiteral("/user-dirs.dirs")) {
         checkDesktopLocation();
     } else {
-        // Emitting FilesAdded forces a re-read of the dir
-        QUrl url;
-        url.setScheme(QStringLiteral("desktop"));
-        const auto relativePath = QDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).relativeFilePath(path);
-        url.setPath(QStringLiteral("%1/%2").arg(url.path(), relativePath));
-        url.setPath(QDir::cleanPath(url.path()));
-        org::kde::KDirNotify::emitFilesAdded(url);
+        // Depending on the backend, the path is the one of the directory or of a file in it
+        QString dir = path;
+        if (!m_snapshots.contains(dir)) {
+            dir = QFileInfo(path).path();
+        }
+
+        if (m_snapshots.contains(dir) && QFileInfo(dir).isDir()) {
+            rescan(dir);
+        } else {
+            m_snapshots.remove(dir);
+
+            // Emitting FilesAdded forces a re-read of the dir
+            org::kde::KDirNotify::emitFilesAdded(desktopUrl(path));
+        }
     }
 }
 
@@ -82,8 +95,116 @@ void DesktopNotifier::checkDesktopLocation()
 
     if (m_desktopLocation != currentLocation) {
         m_desktopLocation = currentLocation;
+
+        const QString desktopPath = currentLocation.toLocalFile();
+        if (!m_snapshots.contains(desktopPath)) {
+            m_snapshots.insert(desktopPath, snapshot(desktopPath));
+        }
+        m_trashLinks.clear();
+        m_trashLinksScanned = false;
+
         org::kde::KDirNotify::emitFilesChanged(QList<QUrl>() << QUrl(QStringLiteral("desktop:/")));
     }
 }
 
+DesktopNotifier::DirSnapshot DesktopNotifier::snapshot(const QString &dir)
+{
+    DirSnapshot snapshot;
+
+    const auto entries = QDir(dir).entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot);
+    snapshot.reserve(entries.count());
+    for (const QFileInfo &fi : entries) {
+        snapshot.insert(fi.fileName(), FileStamp{fi.lastModified().toMSecsSinceEpoch(), fi.size()});
+    }
+
+    return snapshot;
+}
+
+void DesktopNotifier::rescan(const QString &dir)
+{
+    const DirSnapshot current = snapshot(dir);
+    DirSnapshot &previous = m_snapshots[dir];
+
+    const bool isDesktop = dir == QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
+
+    bool added = false;
+    QList<QUrl> changed;
+    QList<QUrl> removed;
+
+    for (auto it = current.cbegin(); it != current.cend(); ++it) {
+        const auto previousIt = previous.constFind(it.key());
+        if (previousIt != previous.constEnd() && *previousIt == *it) {
+            continue;
+        }
+
+        const QString path = dir + QLatin1Char('/') + it.key();
+        if (previousIt == previous.constEnd()) {
+            added = true;
+        } else {
+            changed << desktopUrl(path);
+        }
+
+        if (isDesktop) {
+            updateTrashLink(path);
+        }
+    }
+
+    for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+        if (!current.contains(it.key())) {
+            const QString path = dir + QLatin1Char('/') + it.key();
+            removed << desktopUrl(path);
+            m_trashLinks.remove(path);
+        }
+    }
+
+    previous = current;
+
+    if (!removed.isEmpty()) {
+        org::kde::KDirNotify::emitFilesRemoved(removed);
+    }
+    // There is no way to announce single new files, emitting FilesAdded forces a re-read of the dir
+    if (added) {
+        org::kde::KDirNotify::emitFilesAdded(desktopUrl(dir));
+    }
+    if (!changed.isEmpty()) {
+        org::kde::KDirNotify::emitFilesChanged(changed);
+    }
+}
+
+QUrl DesktopNotifier::desktopUrl(const QString &path) const
+{
+    QUrl url;
+    url.setScheme(QStringLiteral("desktop"));
+    const auto relativePath = QDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).relativeFilePath(path);
+    url.setPath(QStringLiteral("%1/%2").arg(url.path(), relativePath));
+    url.setPath(QDir::cleanPath(url.path()));
+    return url;
+}
+
+void DesktopNotifier::scanTrashLinks()
+{
+    m_trashLinks.clear();
+    m_trashLinksScanned = true;
+
+    const auto desktopFiles = QDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).entryInfoList({QStringLiteral("*.desktop")});
+    for (const auto &fi : desktopFiles) {
+        updateTrashLink(fi.absoluteFilePath());
+    }
+}
+
+void DesktopNotifier::updateTrashLink(const QString &path)
+{
+    // Until they are needed, a scan will find them
+    if (!m_trashLinksScanned || !path.endsWith(QLatin1String(".desktop"))) {
+        return;
+    }
+
+    KDesktopFile df(path);
+    if (df.hasLinkType() && df.readUrl() == QLatin1String("trash:/")) {
+        m_trashLinks.insert(path);
+    } else {
+        m_trashLinks.remove(path);
+    }
+}
+
 #include <desktopnotifier.moc>
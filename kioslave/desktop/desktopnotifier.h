@@ -7,6 +7,8 @@
 #pragma once
 
 #include <QDBusAbstractAdaptor>
+#include <QHash>
+#include <QSet>
 #include <QUrl>
 #include <kdedmodule.h>
 
@@ -28,8 +30,32 @@ private Q_SLOTS:
     void dirty(const QString &path);
 
 private:
+    struct FileStamp {
+        qint64 lastModified;
+        qint64 size;
+
+        bool operator==(const FileStamp &other) const
+        {
+            return lastModified == other.lastModified && size == other.size;
+        }
+    };
+    // File name to stamp, for the entries of a watched directory
+    using DirSnapshot = QHash<QString, FileStamp>;
+
     void checkDesktopLocation();
 
+    static DirSnapshot snapshot(const QString &dir);
+    void rescan(const QString &dir);
+    QUrl desktopUrl(const QString &path) const;
+
+    void scanTrashLinks();
+    void updateTrashLink(const QString &path);
+
     KDirWatch *dirWatch;
     QUrl m_desktopLocation;
+
+    QHash<QString, DirSnapshot> m_snapshots;
+    // Desktop files linking to trash:/, whose icon follows the trash state
+    QSet<QString> m_trashLinks;
+    bool m_trashLinksScanned = false;
 };
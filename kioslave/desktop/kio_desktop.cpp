@@ -44,6 +44,7 @@ int Q_DECL_EXPORT kdemain(int argc, char **argv)
 
 DesktopProtocol::DesktopProtocol(const QByteArray &protocol, const QByteArray &pool, const QByteArray &app)
     : KIO::ForwardingSlaveBase(protocol, pool, app)
+    , m_entryCache(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/kio_desktop/entries.cache"))
 {
     checkLocalInstall();
 
@@ -117,8 +118,12 @@ bool DesktopProtocol::rewriteUrl(const QUrl &url, QUrl &newUrl)
 
 void DesktopProtocol::listDir(const QUrl &url)
 {
+    m_entryCache.refresh();
+
     KIO::ForwardingSlaveBase::listDir(url);
 
+    m_entryCache.save();
+
     QUrl actual;
     rewriteUrl(url, actual);
 
@@ -155,13 +160,12 @@ void DesktopProtocol::prepareUDSEntry(KIO::UDSEntry &entry, bool listing) const
     const QString path = desktopFile(entry);
 
     if (!path.isEmpty()) {
-        KDesktopFile file(path);
+        const DesktopEntryCache::Entry desktopEntry = m_entryCache.entry(path);
 
-        const QString name = file.readName();
-        if (!name.isEmpty())
-            entry.replace(KIO::UDSEntry::UDS_DISPLAY_NAME, name);
+        if (!desktopEntry.name.isEmpty())
+            entry.replace(KIO::UDSEntry::UDS_DISPLAY_NAME, desktopEntry.name);
 
-        if (!file.tryExec())
+        if (desktopEntry.hidden)
             entry.replace(KIO::UDSEntry::UDS_HIDDEN, 1);
     }
 
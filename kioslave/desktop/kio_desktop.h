@@ -8,6 +8,8 @@
 
 #include <kio/forwardingslavebase.h>
 
+#include "desktopentrycache.h"
+
 class DesktopProtocol : public KIO::ForwardingSlaveBase
 {
     Q_OBJECT
@@ -27,4 +29,7 @@ protected:
 
 private:
     void fileSystemFreeSpace(const QUrl &url);
+
+    // Filled while preparing entries, which is const
+    mutable DesktopEntryCache m_entryCache;
 };
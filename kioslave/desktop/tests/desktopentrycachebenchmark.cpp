@@ -0,0 +1,193 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KDesktopFile>
+
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "../desktopentrycache.h"
+
+static const int s_launcherCount = 1000;
+
+class DesktopEntryCacheBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testEntries();
+    void testInvalidation();
+    void benchmarkParse();
+    void benchmarkCached();
+
+private:
+    QString launcherPath(int i) const;
+
+    QTemporaryDir m_dir;
+    QStringList m_launchers;
+};
+
+QString DesktopEntryCacheBenchmark::launcherPath(int i) const
+{
+    return m_dir.filePath(QStringLiteral("launcher%1.desktop").arg(i));
+}
+
+void DesktopEntryCacheBenchmark::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    for (int i = 0; i < s_launcherCount; ++i) {
+        QFile file(launcherPath(i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+
+        file.write("[Desktop Entry]\nType=Application\n");
+        file.write(QStringLiteral("Name=Launcher %1\nName[de]=Starter %1\nName[fr]=Lanceur %1\n").arg(i).toUtf8());
+        file.write("Icon=applications-other\nExec=sh\n");
+        // Every tenth one can not be run
+        if (i % 10 == 0) {
+            file.write("TryExec=kio-desktop-benchmark-does-not-exist\n");
+        } else {
+            file.write("TryExec=sh\n");
+        }
+
+        m_launchers.append(file.fileName());
+    }
+}
+
+void DesktopEntryCacheBenchmark::testEntries()
+{
+    DesktopEntryCache cache(m_dir.filePath(QStringLiteral("cache/entries.cache")));
+    cache.refresh();
+
+    for (int i = 0; i < 20; ++i) {
+        const DesktopEntryCache::Entry entry = cache.entry(launcherPath(i));
+        KDesktopFile file(launcherPath(i));
+        QCOMPARE(entry.name, file.readName());
+        QCOMPARE(entry.hidden, !file.tryExec());
+        QCOMPARE(entry.hidden, i % 10 == 0);
+    }
+
+    cache.save();
+
+    // Read back from disk
+    DesktopEntryCache loaded(m_dir.filePath(QStringLiteral("cache/entries.cache")));
+    loaded.refresh();
+    QCOMPARE(loaded.entry(launcherPath(1)).name, QStringLiteral("Launcher 1"));
+    QVERIFY(loaded.entry(launcherPath(10)).hidden);
+}
+
+void DesktopEntryCacheBenchmark::testInvalidation()
+{
+    const QString path = m_dir.filePath(QStringLiteral("changing.desktop"));
+    auto write = [&path](const QByteArray &name) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("[Desktop Entry]\nType=Application\nExec=sh\nName=" + name + "\n");
+    };
+
+    write("Before");
+    DesktopEntryCache cache(m_dir.filePath(QStringLiteral("cache/changing.cache")));
+    cache.refresh();
+    QCOMPARE(cache.entry(path).name, QStringLiteral("Before"));
+
+    // Different size, even within the same second
+    write("After, longer");
+    QCOMPARE(cache.entry(path).name, QStringLiteral("After, longer"));
+
+    // A program showing up in $PATH
+    const QByteArray originalPath = qgetenv("PATH");
+    QTemporaryDir bin;
+    QVERIFY(bin.isValid());
+    qputenv("PATH", QFile::encodeName(bin.path()) + ':' + originalPath);
+
+    const QString tryExecPath = m_dir.filePath(QStringLiteral("tryexec.desktop"));
+    {
+        QFile file(tryExecPath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("[Desktop Entry]\nType=Application\nExec=sh\nName=TryExec\nTryExec=kio-desktop-benchmark-installed\n");
+    }
+
+    cache.refresh();
+    QVERIFY(cache.entry(tryExecPath).hidden);
+
+    // Make sure the directory gets a different modification time
+    QTest::qWait(1100);
+    {
+        QFile program(bin.filePath(QStringLiteral("kio-desktop-benchmark-installed")));
+        QVERIFY(program.open(QIODevice::WriteOnly));
+        program.write("#!/bin/sh\n");
+        program.close();
+        QVERIFY(program.setPermissions(program.permissions() | QFileDevice::ExeUser));
+    }
+
+    cache.refresh();
+    QVERIFY(!cache.entry(tryExecPath).hidden);
+
+    qputenv("PATH", originalPath);
+
+    // An absolute TryExec, outside of $PATH
+    QTemporaryDir opt;
+    QVERIFY(opt.isValid());
+    const QString program = opt.filePath(QStringLiteral("kio-desktop-benchmark-absolute"));
+    const QString absolutePath = m_dir.filePath(QStringLiteral("absolute.desktop"));
+    {
+        QFile file(absolutePath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("[Desktop Entry]\nType=Application\nExec=sh\nName=Absolute\nTryExec=" + QFile::encodeName(program) + "\n");
+    }
+
+    cache.refresh();
+    QVERIFY(cache.entry(absolutePath).hidden);
+
+    QTest::qWait(1100);
+    {
+        QFile file(program);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("#!/bin/sh\n");
+        file.close();
+        QVERIFY(file.setPermissions(file.permissions() | QFileDevice::ExeUser));
+    }
+
+    cache.refresh();
+    QVERIFY(!cache.entry(absolutePath).hidden);
+}
+
+void DesktopEntryCacheBenchmark::benchmarkParse()
+{
+    QBENCHMARK {
+        for (const QString &path : qAsConst(m_launchers)) {
+            KDesktopFile file(path);
+            QVERIFY(!file.readName().isEmpty());
+            file.tryExec();
+        }
+    }
+}
+
+void DesktopEntryCacheBenchmark::benchmarkCached()
+{
+    const QString cacheFile = m_dir.filePath(QStringLiteral("cache/benchmark.cache"));
+    {
+        DesktopEntryCache cache(cacheFile);
+        cache.refresh();
+        for (const QString &path : qAsConst(m_launchers)) {
+            cache.entry(path);
+        }
+    }
+
+    // Like a listing by a new worker, with the cache on disk from a previous one
+    QBENCHMARK {
+        DesktopEntryCache cache(cacheFile);
+        cache.refresh();
+        for (const QString &path : qAsConst(m_launchers)) {
+            QVERIFY(!cache.entry(path).name.isEmpty());
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(DesktopEntryCacheBenchmark)
+
+#include "desktopentrycachebenchmark.moc"
@@ -0,0 +1,130 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QDBusConnection>
+#include <QDBusVariant>
+#include <QMenu>
+#include <QSignalSpy>
+#include <QtTest>
+
+#include "../dbusmenuimporter.h"
+#include "../dbusmenutypes_p.h"
+
+static const QString s_menuPath = QStringLiteral("/MenuBar");
+
+/**
+ * Exports a flat menu of two items, like an application would
+ */
+class FakeExporter : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.canonical.dbusmenu")
+
+public:
+    uint revision = 1;
+    QString firstLabel = QStringLiteral("First");
+    int layoutRequests = 0;
+
+public Q_SLOTS:
+    uint GetLayout(int parentId, int recursionDepth, const QStringList &propertyNames, DBusMenuLayoutItem &item)
+    {
+        Q_UNUSED(recursionDepth)
+        Q_UNUSED(propertyNames)
+        ++layoutRequests;
+
+        item.id = parentId;
+        item.properties = {{QStringLiteral("children-display"), QStringLiteral("submenu")}};
+        item.children = {
+            DBusMenuLayoutItem{1, {{QStringLiteral("label"), firstLabel}}, {}},
+            DBusMenuLayoutItem{2, {{QStringLiteral("label"), QStringLiteral("Second")}}, {}},
+        };
+        return revision;
+    }
+
+    bool AboutToShow(int id)
+    {
+        // the importer expects the layout of the menu to be announced after asking for a refresh
+        QTimer::singleShot(0, this, [this, id] {
+            Q_EMIT LayoutUpdated(revision, id);
+        });
+        return true;
+    }
+
+    void Event(int id, const QString &eventId, const QDBusVariant &data, uint timestamp)
+    {
+        Q_UNUSED(id)
+        Q_UNUSED(eventId)
+        Q_UNUSED(data)
+        Q_UNUSED(timestamp)
+    }
+
+Q_SIGNALS:
+    void LayoutUpdated(uint revision, int parent);
+};
+
+class DBusMenuImporterTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testUnchangedRevision();
+};
+
+void DBusMenuImporterTest::initTestCase()
+{
+    DBusMenuTypes_register();
+}
+
+void DBusMenuImporterTest::testUnchangedRevision()
+{
+    // on a connection of its own, so that the importer talks to it through the bus
+    QDBusConnection exporterConnection = QDBusConnection::connectToBus(QDBusConnection::SessionBus, QStringLiteral("exporter"));
+    QVERIFY(exporterConnection.isConnected());
+
+    FakeExporter exporter;
+    QVERIFY(exporterConnection.registerObject(s_menuPath, &exporter, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllSignals));
+
+    DBusMenuImporter importer(exporterConnection.baseService(), s_menuPath);
+    QSignalSpy menuUpdated(&importer, &DBusMenuImporter::menuUpdated);
+
+    importer.updateMenu();
+    QVERIFY(menuUpdated.wait());
+    QCOMPARE(exporter.layoutRequests, 1);
+
+    QMenu *menu = importer.menu();
+    QCOMPARE(menu->actions().count(), 2);
+    QAction *first = menu->actions().at(0);
+    QCOMPARE(first->text(), QStringLiteral("First"));
+
+    // the menu is shown again and its layout fetched again, but the revision tells nothing changed
+    exporter.firstLabel = QStringLiteral("Not announced");
+    importer.updateMenu();
+    QVERIFY(menuUpdated.wait());
+    QCOMPARE(exporter.layoutRequests, 2);
+    QCOMPARE(menu->actions().at(0), first);
+    QCOMPARE(first->text(), QStringLiteral("First"));
+
+    // announcing the revision the actions were built from does not fetch anything
+    Q_EMIT exporter.LayoutUpdated(1, 0);
+    QTest::qWait(100);
+    QCOMPARE(exporter.layoutRequests, 2);
+
+    // a new revision is fetched and applied
+    exporter.revision = 2;
+    exporter.firstLabel = QStringLiteral("Renamed");
+    Q_EMIT exporter.LayoutUpdated(2, 0);
+    QTRY_COMPARE(first->text(), QStringLiteral("Renamed"));
+    QCOMPARE(exporter.layoutRequests, 3);
+    QCOMPARE(menu->actions().at(0), first);
+
+    exporterConnection.unregisterObject(s_menuPath);
+    QDBusConnection::disconnectFromBus(QStringLiteral("exporter"));
+}
+
+QTEST_MAIN(DBusMenuImporterTest)
+
+#include "dbusmenuimportertest.moc"
@@ -78,8 +78,33 @@ public:
     QSet<int> m_idsRefreshedByAboutToShow;
     QSet<int> m_pendingLayoutUpdates;
 
+    // Ids of the menus whose layout has been fetched. The others are only
+    // fetched once they are about to be shown (or hovered).
+    QSet<int> m_fetchedIds;
+    // Layout revision the actions of a fetched menu were built from, as returned by
+    // GetLayout. Exporters differ in whether the revision is global or per menu, so
+    // it is only compared with the ones announced or returned for the same menu.
+    // Some exporters always send 0, which is never taken as unchanged.
+    QHash<int, uint> m_revisionForId;
+
+    bool isUpToDate(int id, uint revision) const
+    {
+        auto it = m_revisionForId.constFind(id);
+        return revision != 0 && it != m_revisionForId.constEnd() && *it == revision;
+    }
+    // GetLayout calls waiting for a reply, and the ones to send again once they got it
+    QSet<int> m_layoutRequestsInFlight;
+    QSet<int> m_layoutRequestsQueued;
+
     QDBusPendingCallWatcher *refresh(int id)
     {
+        if (m_layoutRequestsInFlight.contains(id)) {
+            // the reply might be outdated already, fetch again once it arrived
+            m_layoutRequestsQueued << id;
+            return nullptr;
+        }
+        m_layoutRequestsInFlight << id;
+
         auto call = m_interface->GetLayout(id, 1, QStringList());
         QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, q);
         watcher->setProperty(DBUSMENU_PROPERTY_ID, id);
@@ -281,8 +306,6 @@ DBusMenuImporter::DBusMenuImporter(const QString &service, const QString &path,
             [this](const DBusMenuItemList &updatedList, const DBusMenuItemKeysList &removedList) {
                 d->slotItemsPropertiesUpdated(updatedList, removedList);
             });
-
-    d->refresh(0);
 }
 
 DBusMenuImporter::~DBusMenuImporter()
@@ -296,10 +319,17 @@ DBusMenuImporter::~DBusMenuImporter()
 
 void DBusMenuImporter::slotLayoutUpdated(uint revision, int parentId)
 {
-    Q_UNUSED(revision)
     if (d->m_idsRefreshedByAboutToShow.remove(parentId)) {
         return;
     }
+    if (!d->m_fetchedIds.contains(parentId)) {
+        // never fetched, it will be when about to be shown
+        return;
+    }
+    if (d->isUpToDate(parentId, revision)) {
+        // our actions already reflect this revision
+        return;
+    }
     d->m_pendingLayoutUpdates << parentId;
     if (!d->m_pendingLayoutUpdateTimer->isActive()) {
         d->m_pendingLayoutUpdateTimer->start();
@@ -369,6 +399,13 @@ void DBusMenuImporter::slotGetLayoutFinished(QDBusPendingCallWatcher *watcher)
     int parentId = watcher->property(DBUSMENU_PROPERTY_ID).toInt();
     watcher->deleteLater();
 
+    d->m_layoutRequestsInFlight.remove(parentId);
+    if (d->m_layoutRequestsQueued.remove(parentId)) {
+        // a newer layout was requested meanwhile, skip building this one
+        d->refresh(parentId);
+        return;
+    }
+
     QMenu *menu = d->menuForId(parentId);
 
     QDBusPendingReply<uint, DBusMenuLayoutItem> reply = *watcher;
@@ -383,6 +420,7 @@ void DBusMenuImporter::slotGetLayoutFinished(QDBusPendingCallWatcher *watcher)
 #ifdef BENCHMARK
     DMDEBUG << "- items received:" << sChrono.elapsed() << "ms";
 #endif
+    const uint revision = reply.argumentAt<0>();
     DBusMenuLayoutItem rootItem = reply.argumentAt<1>();
 
     if (!menu) {
@@ -390,6 +428,15 @@ void DBusMenuImporter::slotGetLayoutFinished(QDBusPendingCallWatcher *watcher)
         return;
     }
 
+    if (d->m_fetchedIds.contains(parentId) && d->isUpToDate(parentId, revision)) {
+        // refetched, e.g. on AboutToShow, but nothing changed since our actions were built
+        Q_EMIT menuUpdated(menu);
+        return;
+    }
+
+    d->m_fetchedIds.insert(parentId);
+    d->m_revisionForId.insert(parentId, revision);
+
     // remove outdated actions
     QSet<int> newDBusMenuItemIds;
     newDBusMenuItemIds.reserve(rootItem.children.count());
@@ -421,6 +468,8 @@ void DBusMenuImporter::slotGetLayoutFinished(QDBusPendingCallWatcher *watcher)
 
             connect(action, &QObject::destroyed, this, [this, id]() {
                 d->m_actionForId.remove(id);
+                d->m_fetchedIds.remove(id);
+                d->m_revisionForId.remove(id);
             });
 
             connect(action, &QAction::triggered, this, [id, this]() {
@@ -431,6 +480,7 @@ void DBusMenuImporter::slotGetLayoutFinished(QDBusPendingCallWatcher *watcher)
                 connect(menuAction, &QMenu::aboutToShow, this, &DBusMenuImporter::slotMenuAboutToShow, Qt::UniqueConnection);
             }
             connect(menu, &QMenu::aboutToHide, this, &DBusMenuImporter::slotMenuAboutToHide, Qt::UniqueConnection);
+            connect(menu, &QMenu::hovered, this, &DBusMenuImporter::slotMenuHovered, Qt::UniqueConnection);
 
             menu->addAction(action);
         } else {
@@ -517,6 +567,20 @@ void DBusMenuImporter::slotMenuAboutToHide()
     d->sendEvent(id, QStringLiteral("closed"));
 }
 
+void DBusMenuImporter::slotMenuHovered(QAction *action)
+{
+    // Fetch the layout of a submenu before it gets opened, so that it can be
+    // shown right away. AboutToShow is still sent when it is actually shown.
+    if (!action->menu()) {
+        return;
+    }
+
+    int id = action->property(DBUSMENU_PROPERTY_ID).toInt();
+    if (!d->m_fetchedIds.contains(id) && !d->m_layoutRequestsInFlight.contains(id)) {
+        d->refresh(id);
+    }
+}
+
 void DBusMenuImporter::slotMenuAboutToShow()
 {
     QMenu *menu = qobject_cast<QMenu *>(sender());
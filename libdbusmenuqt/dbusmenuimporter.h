@@ -26,6 +26,9 @@ class DBusMenuImporter : public QObject
 public:
     /**
      * Creates a DBusMenuImporter listening over DBus on service, path
+     *
+     * Nothing is fetched until updateMenu() is called, submenus are fetched
+     * when they are about to be shown, or speculatively when hovered.
      */
     DBusMenuImporter(const QString &service, const QString &path, QObject *parent = nullptr);
 
@@ -78,6 +81,7 @@ private Q_SLOTS:
     void sendClickedEvent(int);
     void slotMenuAboutToShow();
     void slotMenuAboutToHide();
+    void slotMenuHovered(QAction *action);
     void slotAboutToShowDBusCallFinished(QDBusPendingCallWatcher *);
     void slotItemActivationRequested(int id, uint timestamp);
     void processPendingLayoutUpdates();
@@ -0,0 +1,167 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "appletmetadatacatalog.h"
+#include "libkworkspace_debug.h"
+
+#include <KPackage/PackageLoader>
+#include <KSycoca>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QSet>
+#include <QStandardPaths>
+#include <QTimer>
+
+#include <algorithm>
+
+static const QString s_packageRoot = QStringLiteral("plasma/plasmoids");
+static const QString s_pluginNamespace = QStringLiteral("plasma/applets");
+
+class AppletMetaDataCatalogSingleton
+{
+public:
+    AppletMetaDataCatalog self;
+};
+
+Q_GLOBAL_STATIC(AppletMetaDataCatalogSingleton, s_catalog)
+
+AppletMetaDataCatalog *AppletMetaDataCatalog::self()
+{
+    return &s_catalog()->self;
+}
+
+AppletMetaDataCatalog::AppletMetaDataCatalog()
+    : m_watcher(new QFileSystemWatcher(this))
+    , m_changedTimer(new QTimer(this))
+{
+    // installing a package touches the folders several times in a row
+    m_changedTimer->setSingleShot(true);
+    m_changedTimer->setInterval(500);
+    connect(m_changedTimer, &QTimer::timeout, this, &AppletMetaDataCatalog::changed);
+
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &AppletMetaDataCatalog::invalidate);
+    // also covers applets installed in ways not touching the watched folders, e.g. by the package manager
+    connect(KSycoca::self(), &KSycoca::databaseChanged, this, &AppletMetaDataCatalog::invalidate);
+}
+
+AppletMetaDataCatalog::~AppletMetaDataCatalog() = default;
+
+QList<KPluginMetaData> AppletMetaDataCatalog::applets()
+{
+    ensureLoaded();
+    return m_applets.toList();
+}
+
+QList<KPluginMetaData> AppletMetaDataCatalog::appletsProviding(const QString &provides)
+{
+    ensureLoaded();
+    return appletsAt(m_providesRows.value(provides));
+}
+
+QList<KPluginMetaData> AppletMetaDataCatalog::containmentsOfType(const QString &type)
+{
+    ensureLoaded();
+
+    const QString key = QStringLiteral("X-Plasma-ContainmentType");
+    QList<KPluginMetaData> containments;
+
+    for (const KPluginMetaData &applet : qAsConst(m_applets)) {
+        if (applet.value(key) == type) {
+            containments << applet;
+        }
+    }
+
+    return containments;
+}
+
+void AppletMetaDataCatalog::ensureLoaded()
+{
+    if (!m_loaded) {
+        load();
+        watchFolders();
+        m_loaded = true;
+    }
+}
+
+void AppletMetaDataCatalog::load()
+{
+    m_applets.clear();
+    m_providesRows.clear();
+
+    // compiled applets first, they win over packages of the same id
+    QList<KPluginMetaData> applets = KPluginMetaData::findPlugins(s_pluginNamespace);
+    const int pluginCount = applets.size();
+    applets << KPackage::PackageLoader::self()->findPackages(QStringLiteral("Plasma/Applet"), s_packageRoot);
+    m_applets.reserve(applets.size());
+
+    QSet<QString> pluginIds;
+    for (const KPluginMetaData &applet : qAsConst(applets)) {
+        if (!applet.isValid() || pluginIds.contains(applet.pluginId())) {
+            continue;
+        }
+
+        const int row = m_applets.size();
+        m_applets.append(applet);
+        pluginIds.insert(applet.pluginId());
+
+        const QStringList provides = applet.value(QStringLiteral("X-Plasma-Provides"), QStringList());
+        for (const QString &p : provides) {
+            m_providesRows[p].append(row);
+        }
+    }
+
+    qCDebug(LIBKWORKSPACE_DEBUG) << "Loaded metadata of" << m_applets.size() << "applets," << pluginCount << "of them compiled";
+}
+
+void AppletMetaDataCatalog::invalidate()
+{
+    m_loaded = false;
+    m_changedTimer->start();
+}
+
+void AppletMetaDataCatalog::watchFolders()
+{
+    QStringList folders =
+        QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, s_packageRoot, QStandardPaths::LocateDirectory);
+
+    // the user folder might not exist yet, watch its parent to notice the first package install
+    const QString userFolder = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QLatin1Char('/') + s_packageRoot;
+    if (!folders.contains(userFolder)) {
+        QString folder = userFolder;
+        while (!QDir(folder).exists()) {
+            folder = QFileInfo(folder).absolutePath();
+        }
+        folders << folder;
+    }
+
+    const QStringList libraryPaths = QCoreApplication::libraryPaths();
+    for (const QString &libraryPath : libraryPaths) {
+        const QString folder = libraryPath + QLatin1Char('/') + s_pluginNamespace;
+        if (QDir(folder).exists()) {
+            folders << folder;
+        }
+    }
+
+    const QStringList watched = m_watcher->directories();
+    for (const QString &folder : qAsConst(folders)) {
+        if (!watched.contains(folder)) {
+            m_watcher->addPath(folder);
+        }
+    }
+}
+
+QList<KPluginMetaData> AppletMetaDataCatalog::appletsAt(const QVector<int> &rows) const
+{
+    QList<KPluginMetaData> applets;
+    applets.reserve(rows.size());
+    for (int row : rows) {
+        applets << m_applets.at(row);
+    }
+    return applets;
+}
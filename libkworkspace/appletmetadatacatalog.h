@@ -0,0 +1,85 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "kworkspace_export.h"
+
+#include <KPluginMetaData>
+
+#include <QHash>
+#include <QObject>
+#include <QVector>
+
+class QFileSystemWatcher;
+class QTimer;
+
+/**
+ * Process wide catalog of the metadata of all installed applets and containments,
+ * both packaged ones and compiled ones in the plasma/applets plugin namespace,
+ * like Plasma::PluginLoader::listAppletMetaData() lists them.
+ *
+ * Walking the plasmoid packages and parsing their metadata is expensive, so it is
+ * done once, lazily on first use, and shared by everything in the process needing it
+ * (widget explorer and its alternatives filter, system tray, add panel menu...).
+ * The package and plugin folders and the service database are watched, and the
+ * catalog is reloaded on the next query after they changed.
+ *
+ * Only to be used from the GUI thread.
+ */
+class KWORKSPACE_EXPORT AppletMetaDataCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AppletMetaDataCatalog *self();
+
+    /**
+     * @return metadata of all applets, including containments
+     */
+    QList<KPluginMetaData> applets();
+
+    /**
+     * @return applets listing @p provides in X-Plasma-Provides
+     */
+    QList<KPluginMetaData> appletsProviding(const QString &provides);
+
+    /**
+     * @return all containments whose X-Plasma-ContainmentType is @p type
+     */
+    QList<KPluginMetaData> containmentsOfType(const QString &type);
+
+    /**
+     * Reloads the catalog on the next query, and emits changed() shortly after.
+     * The folders are watched already; call this when you learned about a change
+     * before the watcher could, e.g. from a package install notification.
+     */
+    void invalidate();
+
+Q_SIGNALS:
+    /**
+     * Emitted when applets got installed, updated or removed
+     */
+    void changed();
+
+private:
+    AppletMetaDataCatalog();
+    ~AppletMetaDataCatalog() override;
+
+    void ensureLoaded();
+    void load();
+    void watchFolders();
+    QList<KPluginMetaData> appletsAt(const QVector<int> &rows) const;
+
+    bool m_loaded = false;
+    QFileSystemWatcher *m_watcher;
+    QTimer *m_changedTimer;
+
+    QVector<KPluginMetaData> m_applets;
+    QHash<QString /*provides*/, QVector<int>> m_providesRows;
+
+    friend class AppletMetaDataCatalogSingleton;
+};
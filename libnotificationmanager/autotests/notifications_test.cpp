@@ -7,6 +7,8 @@
 
 #include <QDebug>
 #include <QObject>
+#include <QRandomGenerator>
+#include <QXmlStreamReader>
 #include <QtTest>
 
 #include "notification.h"
@@ -25,6 +27,9 @@ public:
 private Q_SLOTS:
     void parse_data();
     void parse();
+    void fuzzSanitize();
+    void benchmarkSanitize_data();
+    void benchmarkSanitize();
 
     void compressNotificationRemoval();
 };
@@ -67,6 +72,18 @@ void NotificationTest::parse_data()
     QTest::newRow("image remote URL space in element name") << "This is < img src=\"http://foo.com/boo.png\" alt=\"cheese\" /> and more text" << "This is ";
 
     QTest::newRow("link") << "This is a link <a href=\"http://foo.com/boo\"/> and more text" << "This is a link <a href=\"http://foo.com/boo\"/> and more text";
+    QTest::newRow("link escaped attribute") << "<a href='http://foo.com/?a=1&amp;b=\"2\"'>link</a>" << "<a href=\"http://foo.com/?a=1&amp;b=&quot;2&quot;\">link</a>";
+
+    QTest::newRow("br tags and newlines") << "I am<br/>\n <br/>the notification" << "I am<br/>the notification";
+    QTest::newRow("space after single newline") << "I am\n the notification" << "I am<br/> the notification";
+    QTest::newRow("empty element") << "I am <b></b>the notification" << "I am <b/>the notification";
+    QTest::newRow("stray entity") << "I am&nbsp;the notification" << "I am&amp;nbsp;the notification";
+    QTest::newRow("character reference") << "I am th&#233; notification&#x1F514;" << "I am th\u00e9 notification\U0001F514";
+    QTest::newRow("invalid character reference") << "I am &#0; the notification" << "I am &amp;#0; the notification";
+    QTest::newRow("escaped in plain text") << "I am \"the\" notification > you" << "I am &quot;the&quot; notification &gt; you";
+    QTest::newRow("comment") << "I am <!-- <b> --> the notification" << "I am the notification";
+    QTest::newRow("cdata") << "I am <![CDATA[<b>the</b>]]> notification" << "I am &lt;b&gt;the&lt;/b&gt; notification";
+    QTest::newRow("mismatched end tag") << "I am <b>the</i> notification" << "I am <b>the</b>";
     // clang-format on
 }
 
@@ -83,6 +100,115 @@ void NotificationTest::parse()
     QCOMPARE(notification.body(), expectedOut);
 }
 
+void NotificationTest::fuzzSanitize()
+{
+    // Bits of markup, well-formed or not, put together at random
+    const QStringList pieces = {
+        QStringLiteral("text"),
+        QStringLiteral(" "),
+        QStringLiteral("\n"),
+        QStringLiteral("\t"),
+        QStringLiteral("<b>"),
+        QStringLiteral("</b>"),
+        QStringLiteral("<i>"),
+        QStringLiteral("</i>"),
+        QStringLiteral("<br/>"),
+        QStringLiteral("<blink>"),
+        QStringLiteral("</blink>"),
+        QStringLiteral("<table><tr><td>"),
+        QStringLiteral("</td></tr></table>"),
+        QStringLiteral("&"),
+        QStringLiteral("&amp;"),
+        QStringLiteral("&#38;"),
+        QStringLiteral("&#x1F600;"),
+        QStringLiteral("&#0;"),
+        QStringLiteral("&nbsp;"),
+        QStringLiteral("<"),
+        QStringLiteral(">"),
+        QStringLiteral("\""),
+        QStringLiteral("'"),
+        QStringLiteral("<img src=\"file:///tmp/a.png\" alt=\"a\"/>"),
+        QStringLiteral("<img src=\"http://example.com/a.png\" alt=\"b\">"),
+        QStringLiteral("<img src='https://example.com/b.png'/>"),
+        QStringLiteral("<a href=\"https://kde.org\">"),
+        QStringLiteral("</a>"),
+        QStringLiteral("<!-- comment -->"),
+        QStringLiteral("<![CDATA[<b>]]>"),
+        QStringLiteral("<html>"),
+        QStringLiteral("</html>"),
+        QStringLiteral("\u00e9"),
+        QString(QChar(0x1)),
+    };
+
+    const QStringList allowedTags = {"b", "i", "u", "img", "a", "html", "br", "table", "tr", "td"};
+
+    QRandomGenerator generator(42);
+    for (int i = 0; i < 5000; ++i) {
+        QString messageIn;
+        const int count = generator.bounded(1, 20);
+        for (int j = 0; j < count; ++j) {
+            // Every now and then any ASCII character
+            if (generator.bounded(4) == 0) {
+                messageIn += QChar(generator.bounded(128));
+            } else {
+                messageIn += pieces.at(generator.bounded(pieces.count()));
+            }
+        }
+
+        NotificationManager::Notification notification;
+        notification.setBody(messageIn);
+
+        const QString body = notification.body();
+        if (body.isEmpty()) {
+            continue;
+        }
+
+        const QByteArray context = QByteArray("in: ") + messageIn.toUtf8() + " out: " + body.toUtf8();
+
+        // Whatever comes in, what goes out is well-formed and only has what we allow
+        QXmlStreamReader reader(body);
+        while (!reader.atEnd()) {
+            reader.readNext();
+            if (reader.isStartElement()) {
+                const QString name = reader.name().toString();
+                QVERIFY2(allowedTags.contains(name), context.constData());
+
+                if (name == QLatin1String("img")) {
+                    const QString src = reader.attributes().value(QLatin1String("src")).toString();
+                    QVERIFY2(src.isEmpty() || QUrl(src).isLocalFile(), context.constData());
+                }
+            }
+        }
+        QVERIFY2(!reader.hasError(), (context + " error: " + reader.errorString().toUtf8()).constData());
+        QVERIFY2(body.startsWith(QLatin1String("<?xml version=\"1.0\"?><html")), context.constData());
+    }
+}
+
+void NotificationTest::benchmarkSanitize_data()
+{
+    QTest::addColumn<QString>("messageIn");
+
+    const QString markup = QStringLiteral(
+        "<b>Alice</b> replied to you in <a href=\"https://chat.example.com/room/1\">#plasma</a>:\n"
+        "Did you see the &quot;notifications&quot; patch? It&apos;s fast &amp; small\n\n"
+        "<img src=\"file:///home/alice/avatar.png\" alt=\"avatar\"/> <i>sent from my phone</i>");
+
+    QTest::newRow("plain") << QStringLiteral("Alice: Did you see the notifications patch? It is fast and small, sent from my phone");
+    QTest::newRow("markup") << markup;
+    QTest::newRow("long markup") << markup.repeated(50);
+}
+
+void NotificationTest::benchmarkSanitize()
+{
+    QFETCH(QString, messageIn);
+
+    NotificationManager::Notification notification;
+    QBENCHMARK {
+        notification.setBody(messageIn);
+    }
+    QVERIFY(!notification.body().isEmpty());
+}
+
 void NotificationTest::compressNotificationRemoval()
 {
     const int notificationCount = 10;
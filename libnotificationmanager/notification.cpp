@@ -9,11 +9,13 @@
 #include "notification.h"
 #include "notification_p.h"
 
+#include <algorithm>
+
 #include <QDBusArgument>
 #include <QDebug>
 #include <QImageReader>
 #include <QRegularExpression>
-#include <QXmlStreamReader>
+#include <QVector>
 
 #include <KApplicationTrader>
 #include <KConfig>
@@ -30,88 +32,585 @@ Notification::Private::Private()
 
 Notification::Private::~Private() = default;
 
-QString Notification::Private::sanitize(const QString &text)
+namespace
 {
-    // replace all \ns with <br/>
-    QString t = text;
-
-    t.replace(QLatin1String("\n"), QStringLiteral("<br/>"));
-    // Now remove all inner whitespace (\ns are already <br/>s)
-    t = t.simplified();
-    // Finally, check if we don't have multiple <br/>s following,
-    // can happen for example when "\n       \n" is sent, this replaces
-    // all <br/>s in succession with just one
-    static const QRegularExpression brExpr(QStringLiteral("<br/>\\s*<br/>(\\s|<br/>)*"));
-    t.replace(brExpr, QLatin1String("<br/>"));
-    // This fancy RegExp escapes every occurrence of & since QtQuick Text will blatantly cut off
-    // text where it finds a stray ampersand.
-    // Only &{apos, quot, gt, lt, amp}; as well as &#123 character references will be allowed
-    static const QRegularExpression escapeExpr(QStringLiteral("&(?!(?:apos|quot|[gl]t|amp);|#)"));
-    t.replace(escapeExpr, QLatin1String("&amp;"));
-
-    // Don't bother adding some HTML structure if the body is now empty
-    if (t.isEmpty()) {
-        return t;
-    }
-
-    QXmlStreamReader r(QStringLiteral("<html>") + t + QStringLiteral("</html>"));
-    QString result;
-    QXmlStreamWriter out(&result);
+const QLatin1String s_xmlDeclaration("<?xml version=\"1.0\"?>");
+
+bool isAllowedTag(QStringView name)
+{
+    static const QLatin1String allowedTags[] = {QLatin1String("b"),
+                                                QLatin1String("i"),
+                                                QLatin1String("u"),
+                                                QLatin1String("img"),
+                                                QLatin1String("a"),
+                                                QLatin1String("html"),
+                                                QLatin1String("br"),
+                                                QLatin1String("table"),
+                                                QLatin1String("tr"),
+                                                QLatin1String("td")};
+    return std::any_of(std::begin(allowedTags), std::end(allowedTags), [name](QLatin1String tag) {
+        return name == tag;
+    });
+}
+
+bool isNameStartChar(QChar c)
+{
+    return c.isLetter() || c == QLatin1Char('_') || c == QLatin1Char(':');
+}
+
+bool isNameChar(QChar c)
+{
+    return isNameStartChar(c) || c.isDigit() || c == QLatin1Char('-') || c == QLatin1Char('.');
+}
+
+bool isXmlChar(uint ucs4)
+{
+    return ucs4 == 0x9 || ucs4 == 0xA || ucs4 == 0xD || (ucs4 >= 0x20 && ucs4 <= 0xD7FF) || (ucs4 >= 0xE000 && ucs4 <= 0xFFFD)
+        || (ucs4 >= 0x10000 && ucs4 <= 0x10FFFF);
+}
+
+// Markup, entities, line breaks and what would need escaping,
+// anything else only needs its whitespace simplified
+bool needsParsing(const QString &text)
+{
+    return std::any_of(text.cbegin(), text.cend(), [](QChar c) {
+        const ushort u = c.unicode();
+        return u == '<' || u == '>' || u == '&' || u == '"' || u == '\n' || (u < 0x20 && !c.isSpace());
+    });
+}
+
+// Length of the entity or character reference @p text starts with, or 0 for a stray ampersand.
+// Only &{apos, quot, gt, lt, amp}; and character references are known to QtQuick Text.
+int entityAt(QStringView text, uint &ucs4)
+{
+    static const struct {
+        QLatin1String name;
+        char16_t character;
+    } entities[] = {
+        {QLatin1String("&amp;"), u'&'},
+        {QLatin1String("&lt;"), u'<'},
+        {QLatin1String("&gt;"), u'>'},
+        {QLatin1String("&quot;"), u'"'},
+        {QLatin1String("&apos;"), u'\''},
+    };
+
+    for (const auto &entity : entities) {
+        if (text.startsWith(entity.name)) {
+            ucs4 = entity.character;
+            return entity.name.size();
+        }
+    }
+
+    if (!text.startsWith(QLatin1String("&#"))) {
+        return 0;
+    }
+
+    int i = 2;
+    uint base = 10;
+    if (i < text.size() && text.at(i) == QLatin1Char('x')) {
+        base = 16;
+        ++i;
+    }
+
+    // More digits than that are out of range anyway
+    const int digitsStart = i;
+    uint value = 0;
+    for (; i < text.size() && i - digitsStart < 8; ++i) {
+        const ushort u = text.at(i).unicode();
+        uint digit;
+        if (u >= '0' && u <= '9') {
+            digit = u - '0';
+        } else if (base == 16 && u >= 'a' && u <= 'f') {
+            digit = u - 'a' + 10;
+        } else if (base == 16 && u >= 'A' && u <= 'F') {
+            digit = u - 'A' + 10;
+        } else {
+            break;
+        }
+        value = value * base + digit;
+    }
 
-    const QVector<QString> allowedTags = {"b", "i", "u", "img", "a", "html", "br", "table", "tr", "td"};
+    if (i == digitsStart || i >= text.size() || text.at(i) != QLatin1Char(';') || !isXmlChar(value)) {
+        return 0;
+    }
 
-    out.writeStartDocument();
-    while (!r.atEnd()) {
-        r.readNext();
+    ucs4 = value;
+    return i + 1;
+}
 
-        if (r.tokenType() == QXmlStreamReader::StartElement) {
-            const QString name = r.name().toString();
-            if (!allowedTags.contains(name)) {
-                continue;
+QString decodeAttribute(QStringView value)
+{
+    QString decoded;
+    decoded.reserve(value.size());
+
+    for (int i = 0; i < value.size();) {
+        uint ucs4 = 0;
+        const int length = value.at(i) == QLatin1Char('&') ? entityAt(value.mid(i), ucs4) : 0;
+        if (length) {
+            if (QChar::requiresSurrogates(ucs4)) {
+                decoded += QChar(QChar::highSurrogate(ucs4));
+                decoded += QChar(QChar::lowSurrogate(ucs4));
+            } else {
+                decoded += QChar(ucs4);
             }
-            out.writeStartElement(name);
-            if (name == QLatin1String("img")) {
-                auto src = r.attributes().value("src").toString();
-                auto alt = r.attributes().value("alt").toString();
-
-                const QUrl url(src);
-                if (url.isLocalFile()) {
-                    out.writeAttribute(QStringLiteral("src"), src);
-                } else {
-                    // image denied for security reasons! Do not copy the image src here!
-                }
+            i += length;
+        } else {
+            decoded += value.at(i).isSpace() ? QLatin1Char(' ') : value.at(i);
+            ++i;
+        }
+    }
+
+    return decoded;
+}
+
+/**
+ * Turns a notification body into the subset of HTML we can display, in one pass.
+ *
+ * The result is the XML document the QtQuick Text in the popups expects: whitespace
+ * is simplified, newlines become <br/> with runs of them collapsed into one, stray
+ * ampersands are escaped and only whitelisted tags and attributes are kept. Like any
+ * XML parser, it stops at the first malformed tag and closes what is still open.
+ */
+class BodySanitizer
+{
+public:
+    explicit BodySanitizer(const QString &text)
+        : m_text(text)
+    {
+    }
+
+    QString run();
+
+private:
+    struct Element {
+        QStringView name;
+        bool allowed;
+    };
 
-                out.writeAttribute(QStringLiteral("alt"), alt);
+    bool parseMarkup();
+    bool parseStartTag();
+    bool parseEndTag();
+    bool skipPast(QLatin1String terminator);
+    QStringView parseName(int &pos) const;
+    void skipWhitespace(int &pos) const;
+
+    void writeTextCharacter(QChar c);
+    void writeEntity();
+    void writeLineBreak();
+    void writeAttribute(QLatin1String name, const QString &value);
+    void writeEscaped(uint ucs4);
+    void flushSpace();
+    void beginOutput();
+    void closeStartTag();
+    void closeElement();
+
+    const QString &m_text;
+    int m_pos = 0;
+
+    QString m_out;
+    QVector<Element> m_elements;
+    // The last allowed start tag is not finished yet, it might turn out to be empty
+    bool m_startTagOpen = false;
+    bool m_pendingSpace = false;
+    bool m_hasContent = false;
+    int m_lineBreaks = 0;
+};
+
+QString BodySanitizer::run()
+{
+    // Escaping rarely grows the text by much
+    m_out.reserve(s_xmlDeclaration.size() + m_text.size() + m_text.size() / 4 + 16);
+    m_out += s_xmlDeclaration;
+    m_out += QLatin1String("<html");
+    m_startTagOpen = true;
+    m_elements.append({QStringView(u"html"), true});
+
+    while (m_pos < m_text.size() && !m_elements.isEmpty()) {
+        const QChar c = m_text.at(m_pos);
+
+        if (c == QLatin1Char('<')) {
+            m_hasContent = true;
+            if (!parseMarkup()) {
+                qCWarning(NOTIFICATIONMANAGER) << "Notification to send to backend contains invalid XML at position" << m_pos;
+                flushSpace();
+                break;
             }
-            if (name == QLatin1Char('a')) {
-                out.writeAttribute(QStringLiteral("href"), r.attributes().value("href").toString());
+        } else if (c == QLatin1Char('&')) {
+            writeEntity();
+        } else {
+            writeTextCharacter(c);
+            ++m_pos;
+        }
+    }
+
+    // Don't bother adding some HTML structure if the body is empty
+    if (!m_hasContent) {
+        return QString();
+    }
+
+    while (!m_elements.isEmpty()) {
+        closeElement();
+    }
+    m_out += QLatin1Char('\n');
+
+    return m_out;
+}
+
+bool BodySanitizer::parseMarkup()
+{
+    const QStringView rest = QStringView(m_text).mid(m_pos);
+
+    if (rest.startsWith(QLatin1String("<!--"))) {
+        return skipPast(QLatin1String("-->"));
+    }
+
+    if (rest.startsWith(QLatin1String("<?"))) {
+        return skipPast(QLatin1String("?>"));
+    }
+
+    if (rest.startsWith(QLatin1String("<![CDATA["))) {
+        const int start = m_pos + 9;
+        const int end = m_text.indexOf(QLatin1String("]]>"), start);
+        if (end < 0) {
+            return false;
+        }
+        for (int i = start; i < end; ++i) {
+            writeTextCharacter(m_text.at(i));
+        }
+        m_pos = end + 3;
+        return true;
+    }
+
+    if (rest.startsWith(QLatin1String("</"))) {
+        return parseEndTag();
+    }
+
+    return parseStartTag();
+}
+
+bool BodySanitizer::parseStartTag()
+{
+    int pos = m_pos + 1;
+    const QStringView name = parseName(pos);
+    if (name.isEmpty()) {
+        return false;
+    }
+
+    QStringView src;
+    QStringView alt;
+    QStringView href;
+    bool selfClosing = false;
+
+    while (true) {
+        const int attributeStart = pos;
+        skipWhitespace(pos);
+        if (pos >= m_text.size()) {
+            return false;
+        }
+
+        if (m_text.at(pos) == QLatin1Char('>')) {
+            ++pos;
+            break;
+        }
+        if (m_text.at(pos) == QLatin1Char('/')) {
+            if (pos + 1 >= m_text.size() || m_text.at(pos + 1) != QLatin1Char('>')) {
+                return false;
             }
+            pos += 2;
+            selfClosing = true;
+            break;
+        }
+
+        // Attributes must be separated by whitespace
+        if (pos == attributeStart) {
+            return false;
         }
 
-        if (r.tokenType() == QXmlStreamReader::EndElement) {
-            const QString name = r.name().toString();
-            if (!allowedTags.contains(name)) {
-                continue;
+        const QStringView attributeName = parseName(pos);
+        if (attributeName.isEmpty()) {
+            return false;
+        }
+
+        skipWhitespace(pos);
+        if (pos >= m_text.size() || m_text.at(pos) != QLatin1Char('=')) {
+            return false;
+        }
+        ++pos;
+        skipWhitespace(pos);
+
+        if (pos >= m_text.size() || (m_text.at(pos) != QLatin1Char('"') && m_text.at(pos) != QLatin1Char('\''))) {
+            return false;
+        }
+        const int valueEnd = m_text.indexOf(m_text.at(pos), pos + 1);
+        if (valueEnd < 0) {
+            return false;
+        }
+        const QStringView value = QStringView(m_text).mid(pos + 1, valueEnd - pos - 1);
+        pos = valueEnd + 1;
+
+        if (attributeName == QLatin1String("src") && src.isNull()) {
+            src = value;
+        } else if (attributeName == QLatin1String("alt") && alt.isNull()) {
+            alt = value;
+        } else if (attributeName == QLatin1String("href") && href.isNull()) {
+            href = value;
+        }
+    }
+
+    m_pos = pos;
+
+    if (name == QLatin1String("br") && selfClosing) {
+        writeLineBreak();
+        return true;
+    }
+
+    const bool allowed = isAllowedTag(name);
+    if (!allowed) {
+        flushSpace();
+    } else {
+        beginOutput();
+        m_out += QLatin1Char('<');
+        m_out.append(name.data(), name.size());
+
+        if (name == QLatin1String("img")) {
+            const QString source = decodeAttribute(src);
+            if (QUrl(source).isLocalFile()) {
+                writeAttribute(QLatin1String("src"), source);
+            } else {
+                // image denied for security reasons! Do not copy the image src here!
             }
-            out.writeEndElement();
+            writeAttribute(QLatin1String("alt"), decodeAttribute(alt));
+        } else if (name == QLatin1String("a")) {
+            writeAttribute(QLatin1String("href"), decodeAttribute(href));
         }
 
-        if (r.tokenType() == QXmlStreamReader::Characters) {
-            const auto text = r.text().toString();
-            out.writeCharacters(text); // this auto escapes chars -> HTML entities
+        m_startTagOpen = true;
+    }
+
+    m_elements.append({name, allowed});
+    if (selfClosing) {
+        closeElement();
+    }
+
+    return true;
+}
+
+bool BodySanitizer::parseEndTag()
+{
+    int pos = m_pos + 2;
+    const QStringView name = parseName(pos);
+    skipWhitespace(pos);
+
+    if (name.isEmpty() || pos >= m_text.size() || m_text.at(pos) != QLatin1Char('>')) {
+        return false;
+    }
+
+    // Every end tag needs to match its start tag
+    if (m_elements.isEmpty() || m_elements.constLast().name != name) {
+        return false;
+    }
+
+    m_pos = pos + 1;
+    flushSpace();
+    closeElement();
+
+    return true;
+}
+
+bool BodySanitizer::skipPast(QLatin1String terminator)
+{
+    const int end = m_text.indexOf(terminator, m_pos);
+    if (end < 0) {
+        return false;
+    }
+    m_pos = end + terminator.size();
+    return true;
+}
+
+QStringView BodySanitizer::parseName(int &pos) const
+{
+    if (pos >= m_text.size() || !isNameStartChar(m_text.at(pos))) {
+        return QStringView();
+    }
+
+    const int start = pos;
+    while (pos < m_text.size() && isNameChar(m_text.at(pos))) {
+        ++pos;
+    }
+    return QStringView(m_text).mid(start, pos - start);
+}
+
+void BodySanitizer::skipWhitespace(int &pos) const
+{
+    while (pos < m_text.size() && m_text.at(pos).isSpace()) {
+        ++pos;
+    }
+}
+
+void BodySanitizer::writeTextCharacter(QChar c)
+{
+    if (c == QLatin1Char('\n')) {
+        writeLineBreak();
+    } else if (c.isSpace()) {
+        // Leading whitespace is dropped, trailing whitespace is never flushed
+        if (m_hasContent) {
+            m_pendingSpace = true;
         }
+    } else if (c.unicode() < 0x20) {
+        // Control characters are not allowed in XML
+    } else {
+        beginOutput();
+        writeEscaped(c.unicode());
     }
-    out.writeEndDocument();
+}
+
+void BodySanitizer::writeEntity()
+{
+    uint ucs4 = 0;
+    const int length = entityAt(QStringView(m_text).mid(m_pos), ucs4);
 
-    if (r.hasError()) {
-        qCWarning(NOTIFICATIONMANAGER) << "Notification to send to backend contains invalid XML: " << r.errorString() << "line" << r.lineNumber() << "col"
-                                       << r.columnNumber();
+    // This escapes a stray ampersand since QtQuick Text will blatantly cut off text where it finds one
+    beginOutput();
+    if (length) {
+        writeEscaped(ucs4);
+        m_pos += length;
+    } else {
+        writeEscaped('&');
+        ++m_pos;
     }
+}
 
-    // The Text.StyledText format handles only html3.2 stuff and &apos; is html4 stuff
-    // so we need to replace it here otherwise it will not render at all.
-    result.replace(QLatin1String("&apos;"), QChar('\''));
+void BodySanitizer::writeLineBreak()
+{
+    m_hasContent = true;
+
+    // Only one <br/> for several in succession, with nothing but whitespace in between,
+    // can happen for example when "\n       \n" is sent
+    if (m_lineBreaks > 0) {
+        m_pendingSpace = false;
+        ++m_lineBreaks;
+        return;
+    }
+
+    beginOutput();
+    m_out += QLatin1String("<br/>");
+    m_lineBreaks = 1;
+}
+
+void BodySanitizer::writeAttribute(QLatin1String name, const QString &value)
+{
+    m_out += QLatin1Char(' ');
+    m_out += name;
+    m_out += QLatin1String("=\"");
+    for (const QChar c : value) {
+        writeEscaped(c.unicode());
+    }
+    m_out += QLatin1Char('"');
+}
+
+void BodySanitizer::writeEscaped(uint ucs4)
+{
+    switch (ucs4) {
+    case '<':
+        m_out += QLatin1String("&lt;");
+        break;
+    case '>':
+        m_out += QLatin1String("&gt;");
+        break;
+    case '&':
+        m_out += QLatin1String("&amp;");
+        break;
+    case '"':
+        m_out += QLatin1String("&quot;");
+        break;
+    default:
+        if (QChar::requiresSurrogates(ucs4)) {
+            m_out += QChar(QChar::highSurrogate(ucs4));
+            m_out += QChar(QChar::lowSurrogate(ucs4));
+        } else {
+            m_out += QChar(ucs4);
+        }
+    }
+}
+
+void BodySanitizer::flushSpace()
+{
+    m_hasContent = true;
+
+    // Whitespace following a collapsed run of line breaks goes with them
+    if (m_pendingSpace && m_lineBreaks < 2) {
+        closeStartTag();
+        m_out += QLatin1Char(' ');
+    }
+    m_pendingSpace = false;
+    m_lineBreaks = 0;
+}
+
+void BodySanitizer::beginOutput()
+{
+    flushSpace();
+    closeStartTag();
+}
+
+void BodySanitizer::closeStartTag()
+{
+    if (m_startTagOpen) {
+        m_out += QLatin1Char('>');
+        m_startTagOpen = false;
+    }
+}
+
+void BodySanitizer::closeElement()
+{
+    const Element element = m_elements.takeLast();
+    if (!element.allowed) {
+        return;
+    }
+
+    // Nothing was written since its start tag, as the XML writer would do it
+    if (m_startTagOpen) {
+        m_out += QLatin1String("/>");
+        m_startTagOpen = false;
+    } else {
+        m_out += QLatin1String("</");
+        m_out.append(element.name.data(), element.name.size());
+        m_out += QLatin1Char('>');
+    }
+}
+}
+
+QString Notification::Private::sanitize(const QString &text)
+{
+    if (needsParsing(text)) {
+        return BodySanitizer(text).run();
+    }
+
+    // Most bodies are plain text, simplify the whitespace right into the document
+    QString result;
+    result.reserve(s_xmlDeclaration.size() + text.size() + 14);
+    result += s_xmlDeclaration;
+    result += QLatin1String("<html>");
+
+    const int contentStart = result.size();
+    bool pendingSpace = false;
+    for (const QChar c : text) {
+        if (c.isSpace()) {
+            pendingSpace = result.size() > contentStart;
+            continue;
+        }
+        if (pendingSpace) {
+            result += QLatin1Char(' ');
+            pendingSpace = false;
+        }
+        result += c;
+    }
+
+    // Don't bother adding some HTML structure if the body is empty
+    if (result.size() == contentStart) {
+        return QString();
+    }
 
+    result += QLatin1String("</html>\n");
     return result;
 }
 
@@ -0,0 +1,204 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include <QObject>
+#include <QStandardItemModel>
+#include <QTest>
+
+#include "abstracttasksmodel.h"
+#include "taskgroupingproxymodel.h"
+
+using namespace TaskManager;
+
+class TaskGroupingProxyModelTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void shouldGroupInsertedWindows();
+    void shouldNotGroupLaunchers();
+    void shouldDissolveGroupOnRemoval();
+    void shouldKeepGroupWhenRepresentativeRemoved();
+    void shouldGroupByChangedAppId();
+    void benchmarkInsertRemove();
+
+private:
+    static QStandardItem *window(const QString &appId);
+    void verifyMapping();
+
+    QStandardItemModel *m_source = nullptr;
+    TaskGroupingProxyModel *m_proxy = nullptr;
+};
+
+QStandardItem *TaskGroupingProxyModelTest::window(const QString &appId)
+{
+    auto *item = new QStandardItem(appId);
+    item->setData(true, AbstractTasksModel::IsWindow);
+    item->setData(appId, AbstractTasksModel::AppId);
+    return item;
+}
+
+void TaskGroupingProxyModelTest::verifyMapping()
+{
+    for (int i = 0; i < m_source->rowCount(); ++i) {
+        const QModelIndex sourceIndex = m_source->index(i, 0);
+        const QModelIndex proxyIndex = m_proxy->mapFromSource(sourceIndex);
+
+        QVERIFY(proxyIndex.isValid());
+        QCOMPARE(m_proxy->mapToSource(proxyIndex), sourceIndex);
+
+        if (proxyIndex.parent().isValid()) {
+            QCOMPARE(m_proxy->index(proxyIndex.row(), 0, proxyIndex.parent()), proxyIndex);
+        }
+    }
+}
+
+void TaskGroupingProxyModelTest::init()
+{
+    m_source = new QStandardItemModel(this);
+    m_proxy = new TaskGroupingProxyModel(this);
+    m_proxy->setSourceModel(m_source);
+}
+
+void TaskGroupingProxyModelTest::cleanup()
+{
+    delete m_proxy;
+    delete m_source;
+}
+
+void TaskGroupingProxyModelTest::shouldGroupInsertedWindows()
+{
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+    m_source->appendRow(window(QStringLiteral("org.kde.konsole")));
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(0, 0)), 3);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(1, 0)), 0);
+    QVERIFY(m_proxy->index(0, 0).data(AbstractTasksModel::IsGroupParent).toBool());
+
+    verifyMapping();
+}
+
+void TaskGroupingProxyModelTest::shouldNotGroupLaunchers()
+{
+    auto *launcher = window(QStringLiteral("org.kde.dolphin"));
+    launcher->setData(false, AbstractTasksModel::IsWindow);
+    m_source->appendRow(launcher);
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+
+    QCOMPARE(m_proxy->rowCount(), 2);
+
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+
+    // The window joins the other window, not the launcher
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(0, 0)), 0);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(1, 0)), 2);
+
+    verifyMapping();
+}
+
+void TaskGroupingProxyModelTest::shouldDissolveGroupOnRemoval()
+{
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+    m_source->appendRow(window(QStringLiteral("org.kde.konsole")));
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+
+    QCOMPARE(m_proxy->rowCount(), 2);
+
+    m_source->removeRow(2);
+
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(0, 0)), 0);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(1, 0)), 0);
+
+    verifyMapping();
+
+    m_source->removeRow(0);
+
+    QCOMPARE(m_proxy->rowCount(), 1);
+    QCOMPARE(m_proxy->index(0, 0).data(AbstractTasksModel::AppId).toString(), QStringLiteral("org.kde.konsole"));
+
+    verifyMapping();
+}
+
+void TaskGroupingProxyModelTest::shouldKeepGroupWhenRepresentativeRemoved()
+{
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+    m_source->appendRow(window(QStringLiteral("org.kde.konsole")));
+
+    m_source->removeRow(0);
+
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(0, 0)), 2);
+
+    verifyMapping();
+
+    // The group is still found through its new first window
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+
+    QCOMPARE(m_proxy->rowCount(), 2);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(0, 0)), 3);
+
+    verifyMapping();
+}
+
+void TaskGroupingProxyModelTest::shouldGroupByChangedAppId()
+{
+    m_source->appendRow(window(QStringLiteral("unknown")));
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+
+    // Like a window which only later tells us what it is
+    m_source->item(0)->setData(QStringLiteral("org.kde.dolphin"), AbstractTasksModel::AppId);
+
+    m_source->appendRow(window(QStringLiteral("org.kde.dolphin")));
+
+    // The new window joins the first matching item, then the other one follows it
+    QCOMPARE(m_proxy->rowCount(), 1);
+    QCOMPARE(m_proxy->rowCount(m_proxy->index(0, 0)), 3);
+    QCOMPARE(m_proxy->mapToSource(m_proxy->index(1, 0, m_proxy->index(0, 0))).row(), 2);
+
+    m_source->appendRow(window(QStringLiteral("unknown")));
+
+    // Nothing is known by the old app id anymore
+    QCOMPARE(m_proxy->rowCount(), 2);
+
+    verifyMapping();
+}
+
+void TaskGroupingProxyModelTest::benchmarkInsertRemove()
+{
+    // Lots of windows and browser tabs of a few dozen applications
+    for (int i = 0; i < 500; ++i) {
+        m_source->appendRow(window(QStringLiteral("org.example.app%1").arg(i % 40)));
+    }
+
+    QCOMPARE(m_proxy->rowCount(), 40);
+
+    QBENCHMARK {
+        for (int i = 0; i < 50; ++i) {
+            m_source->insertRow(i * 7, window(QStringLiteral("org.example.app%1").arg(i)));
+        }
+
+        for (int i = 49; i >= 0; --i) {
+            m_source->removeRow(i * 7);
+        }
+    }
+
+    QCOMPARE(m_proxy->rowCount(), 40);
+    verifyMapping();
+}
+
+QTEST_MAIN(TaskGroupingProxyModelTest)
+
+#include "taskgroupingproxymodeltest.moc"
@@ -8,7 +8,10 @@
 #include "abstracttasksmodel.h"
 #include "tasktools.h"
 
+#include <QHash>
+#include <QMap>
 #include <QSet>
+#include <QUrl>
 
 namespace TaskManager
 {
@@ -26,6 +29,29 @@ public:
 
     QVector<QVector<int> *> rowMap;
 
+    // Top-level items whose first source row is a window, by what appsMatch() compares,
+    // so tryToGroup() doesn't need to look at every other item. The order they were
+    // added to rowMap in is kept, as that's the order they are tried in.
+    struct IndexedItem {
+        quint64 order;
+        QString appId;
+        QUrl launcherUrl;
+    };
+    QHash<const QVector<int> *, IndexedItem> indexedItems;
+    QHash<QString, QMap<quint64, QVector<int> *>> itemsByAppId;
+    QHash<QUrl, QMap<quint64, QVector<int> *>> itemsByLauncherUrl;
+    quint64 itemOrder = 0;
+
+    // Where source rows and sub-lists are in rowMap, rebuilt on demand once it
+    // changed in ways that can't be cheaply applied to it.
+    struct Location {
+        int row = -1;
+        int childRow = -1;
+    };
+    QVector<Location> sourceRowLocations;
+    QHash<const QVector<int> *, int> rowOfSubList;
+    bool lookupValid = false;
+
     QSet<QString> blacklistedAppIds;
     QSet<QString> blacklistedLauncherUrls;
 
@@ -42,6 +68,16 @@ public:
     void sourceDataChanged(QModelIndex topLeft, QModelIndex bottomRight, const QVector<int> &roles = QVector<int>());
     void adjustMap(int anchor, int delta);
 
+    void appendToMap(QVector<int> *sourceRows);
+    void removeFromMap(int row);
+    void clearMap();
+    void indexItem(QVector<int> *sourceRows);
+    void unindexItem(const QVector<int> *sourceRows);
+    QVector<int> *findGroupFor(const QModelIndex &sourceIndex);
+    void ensureLookup();
+    void setLocation(int sourceRow, const Location &location);
+    Location locate(int sourceRow);
+
     void rebuildMap();
     bool shouldGroupTasks();
     void checkGrouping(bool silent = false);
@@ -64,6 +100,187 @@ TaskGroupingProxyModel::Private::~Private()
     qDeleteAll(rowMap);
 }
 
+void TaskGroupingProxyModel::Private::appendToMap(QVector<int> *sourceRows)
+{
+    rowMap.append(sourceRows);
+
+    if (lookupValid) {
+        rowOfSubList.insert(sourceRows, rowMap.count() - 1);
+
+        for (int i = 0; i < sourceRows->count(); ++i) {
+            setLocation(sourceRows->at(i), {rowMap.count() - 1, i});
+        }
+    }
+
+    indexItem(sourceRows);
+}
+
+void TaskGroupingProxyModel::Private::removeFromMap(int row)
+{
+    unindexItem(rowMap.at(row));
+    delete rowMap.takeAt(row);
+
+    lookupValid = false;
+}
+
+void TaskGroupingProxyModel::Private::clearMap()
+{
+    qDeleteAll(rowMap);
+    rowMap.clear();
+
+    indexedItems.clear();
+    itemsByAppId.clear();
+    itemsByLauncherUrl.clear();
+
+    lookupValid = false;
+}
+
+void TaskGroupingProxyModel::Private::indexItem(QVector<int> *sourceRows)
+{
+    // Re-indexing an item keeps its place in line.
+    auto it = indexedItems.constFind(sourceRows);
+    const quint64 order = (it != indexedItems.constEnd()) ? it->order : ++itemOrder;
+
+    unindexItem(sourceRows);
+
+    const QModelIndex &sourceIndex = q->sourceModel()->index(sourceRows->constFirst(), 0);
+
+    // Don't group windows with anything other than windows.
+    if (!sourceIndex.data(AbstractTasksModel::IsWindow).toBool()) {
+        return;
+    }
+
+    const IndexedItem item{order, sourceIndex.data(AbstractTasksModel::AppId).toString(), sourceIndex.data(AbstractTasksModel::LauncherUrlWithoutIcon).toUrl()};
+
+    if (!item.appId.isEmpty()) {
+        itemsByAppId[item.appId].insert(order, sourceRows);
+    }
+
+    if (item.launcherUrl.isValid()) {
+        itemsByLauncherUrl[item.launcherUrl].insert(order, sourceRows);
+    }
+
+    indexedItems.insert(sourceRows, item);
+}
+
+void TaskGroupingProxyModel::Private::unindexItem(const QVector<int> *sourceRows)
+{
+    auto it = indexedItems.find(sourceRows);
+
+    if (it == indexedItems.end()) {
+        return;
+    }
+
+    if (!it->appId.isEmpty()) {
+        auto items = itemsByAppId.find(it->appId);
+        items->remove(it->order);
+
+        if (items->isEmpty()) {
+            itemsByAppId.erase(items);
+        }
+    }
+
+    if (it->launcherUrl.isValid()) {
+        auto items = itemsByLauncherUrl.find(it->launcherUrl);
+        items->remove(it->order);
+
+        if (items->isEmpty()) {
+            itemsByLauncherUrl.erase(items);
+        }
+    }
+
+    indexedItems.erase(it);
+}
+
+QVector<int> *TaskGroupingProxyModel::Private::findGroupFor(const QModelIndex &sourceIndex)
+{
+    const int sourceRow = sourceIndex.row();
+
+    QVector<int> *match = nullptr;
+    quint64 matchOrder = 0;
+
+    // The first item in rowMap matching either by app id or by launcher URL, see appsMatch().
+    auto considerFirst = [sourceRow, &match, &matchOrder](const QMap<quint64, QVector<int> *> &items) {
+        for (auto it = items.constBegin(); it != items.constEnd(); ++it) {
+            // Don't match a row with itself.
+            if (it.value()->constFirst() == sourceRow) {
+                continue;
+            }
+
+            if (!match || it.key() < matchOrder) {
+                match = it.value();
+                matchOrder = it.key();
+            }
+
+            return;
+        }
+    };
+
+    const QString &appId = sourceIndex.data(AbstractTasksModel::AppId).toString();
+
+    if (!appId.isEmpty()) {
+        auto items = itemsByAppId.constFind(appId);
+
+        if (items != itemsByAppId.constEnd()) {
+            considerFirst(*items);
+        }
+    }
+
+    const QUrl &launcherUrl = sourceIndex.data(AbstractTasksModel::LauncherUrlWithoutIcon).toUrl();
+
+    if (launcherUrl.isValid()) {
+        auto items = itemsByLauncherUrl.constFind(launcherUrl);
+
+        if (items != itemsByLauncherUrl.constEnd()) {
+            considerFirst(*items);
+        }
+    }
+
+    return match;
+}
+
+void TaskGroupingProxyModel::Private::ensureLookup()
+{
+    if (lookupValid) {
+        return;
+    }
+
+    sourceRowLocations.fill(Location(), q->sourceModel() ? q->sourceModel()->rowCount() : 0);
+    rowOfSubList.clear();
+    rowOfSubList.reserve(rowMap.count());
+
+    for (int i = 0; i < rowMap.count(); ++i) {
+        const QVector<int> *sourceRows = rowMap.at(i);
+        rowOfSubList.insert(sourceRows, i);
+
+        for (int j = 0; j < sourceRows->count(); ++j) {
+            setLocation(sourceRows->at(j), {i, j});
+        }
+    }
+
+    lookupValid = true;
+}
+
+void TaskGroupingProxyModel::Private::setLocation(int sourceRow, const Location &location)
+{
+    if (sourceRow >= sourceRowLocations.count()) {
+        sourceRowLocations.resize(sourceRow + 1);
+    }
+
+    sourceRowLocations[sourceRow] = location;
+}
+
+TaskGroupingProxyModel::Private::Location TaskGroupingProxyModel::Private::locate(int sourceRow)
+{
+    ensureLookup();
+
+    if (sourceRow < 0 || sourceRow >= sourceRowLocations.count()) {
+        return Location();
+    }
+
+    return sourceRowLocations.at(sourceRow);
+}
+
 bool TaskGroupingProxyModel::Private::isGroup(int row)
 {
     if (row < 0 || row >= rowMap.count()) {
@@ -120,7 +337,7 @@ void TaskGroupingProxyModel::Private::sourceRowsInserted(const QModelIndex &pare
     for (int i = start; i <= end; ++i) {
         if (!shouldGroup || !tryToGroup(q->sourceModel()->index(i, 0))) {
             q->beginInsertRows(QModelIndex(), rowMap.count(), rowMap.count());
-            rowMap.append(new QVector<int>{i});
+            appendToMap(new QVector<int>{i});
             q->endInsertRows();
         }
     }
@@ -136,40 +353,48 @@ void TaskGroupingProxyModel::Private::sourceRowsAboutToBeRemoved(const QModelInd
     }
 
     for (int i = first; i <= last; ++i) {
-        for (int j = 0; j < rowMap.count(); ++j) {
-            const QVector<int> *sourceRows = rowMap.at(j);
-            const int mapIndex = sourceRows->indexOf(i);
-
-            if (mapIndex != -1) {
-                // Remove top-level item.
-                if (sourceRows->count() == 1) {
-                    q->beginRemoveRows(QModelIndex(), j, j);
-                    delete rowMap.takeAt(j);
-                    q->endRemoveRows();
-                    // Dissolve group.
-                } else if (sourceRows->count() == 2) {
-                    const QModelIndex parent = q->index(j, 0);
-                    q->beginRemoveRows(parent, 0, 1);
-                    rowMap[j]->remove(mapIndex);
-                    q->endRemoveRows();
-
-                    // We're no longer a group parent.
-                    Q_EMIT q->dataChanged(parent, parent);
-                    // Remove group member.
-                } else {
-                    const QModelIndex parent = q->index(j, 0);
-                    q->beginRemoveRows(parent, mapIndex, mapIndex);
-                    rowMap[j]->remove(mapIndex);
-                    q->endRemoveRows();
-
-                    // Various roles of the parent evaluate child data, and the
-                    // child list has changed.
-                    Q_EMIT q->dataChanged(parent, parent);
-                }
+        const Location location = locate(i);
 
-                break;
-            }
+        if (location.row == -1) {
+            continue;
+        }
+
+        const int j = location.row;
+        const int mapIndex = location.childRow;
+        QVector<int> *sourceRows = rowMap.at(j);
+
+        // Remove top-level item.
+        if (sourceRows->count() == 1) {
+            q->beginRemoveRows(QModelIndex(), j, j);
+            removeFromMap(j);
+            q->endRemoveRows();
+
+            continue;
         }
+
+        const QModelIndex parent = q->index(j, 0);
+
+        // Dissolve group.
+        if (sourceRows->count() == 2) {
+            q->beginRemoveRows(parent, 0, 1);
+            // Remove group member.
+        } else {
+            q->beginRemoveRows(parent, mapIndex, mapIndex);
+        }
+
+        sourceRows->remove(mapIndex);
+        lookupValid = false;
+
+        // The group is now represented by another source row.
+        if (mapIndex == 0) {
+            indexItem(sourceRows);
+        }
+
+        q->endRemoveRows();
+
+        // We're no longer a group parent, or various roles of the parent
+        // evaluate child data, and the child list has changed.
+        Q_EMIT q->dataChanged(parent, parent);
     }
 }
 
@@ -199,7 +424,19 @@ void TaskGroupingProxyModel::Private::sourceModelReset()
 
 void TaskGroupingProxyModel::Private::sourceDataChanged(QModelIndex topLeft, QModelIndex bottomRight, const QVector<int> &roles)
 {
+    // The group lookup is by app id and launcher URL, keep it current.
+    const bool identityChanged = roles.isEmpty() || roles.contains(AbstractTasksModel::AppId) || roles.contains(AbstractTasksModel::LauncherUrl)
+        || roles.contains(AbstractTasksModel::LauncherUrlWithoutIcon);
+
     for (int i = topLeft.row(); i <= bottomRight.row(); ++i) {
+        if (identityChanged) {
+            const Location location = locate(i);
+
+            if (location.childRow == 0) {
+                indexItem(rowMap.at(location.row));
+            }
+        }
+
         const QModelIndex &sourceIndex = q->sourceModel()->index(i, 0);
         QModelIndex proxyIndex = q->mapFromSource(sourceIndex);
 
@@ -224,7 +461,7 @@ void TaskGroupingProxyModel::Private::sourceDataChanged(QModelIndex topLeft, QMo
             && !sourceIndex.data(AbstractTasksModel::IsDemandingAttention).toBool()) {
             if (shouldGroupTasks() && tryToGroup(sourceIndex)) {
                 q->beginRemoveRows(QModelIndex(), proxyIndex.row(), proxyIndex.row());
-                delete rowMap.takeAt(proxyIndex.row());
+                removeFromMap(proxyIndex.row());
                 q->endRemoveRows();
             } else {
                 Q_EMIT q->dataChanged(proxyIndex, proxyIndex, roles);
@@ -237,6 +474,8 @@ void TaskGroupingProxyModel::Private::sourceDataChanged(QModelIndex topLeft, QMo
 
 void TaskGroupingProxyModel::Private::adjustMap(int anchor, int delta)
 {
+    lookupValid = false;
+
     for (int i = 0; i < rowMap.count(); ++i) {
         QVector<int> *sourceRows = rowMap.at(i);
         for (auto it = sourceRows->begin(); it != sourceRows->end(); ++it) {
@@ -249,15 +488,14 @@ void TaskGroupingProxyModel::Private::adjustMap(int anchor, int delta)
 
 void TaskGroupingProxyModel::Private::rebuildMap()
 {
-    qDeleteAll(rowMap);
-    rowMap.clear();
+    clearMap();
 
     const int rows = q->sourceModel()->rowCount();
 
     rowMap.reserve(rows);
 
     for (int i = 0; i < rows; ++i) {
-        rowMap.append(new QVector<int>{i});
+        appendToMap(new QVector<int>{i});
     }
 
     checkGrouping(true /* silent */);
@@ -302,7 +540,7 @@ void TaskGroupingProxyModel::Private::checkGrouping(bool silent)
 
             if (tryToGroup(q->sourceModel()->index(rowMap.at(i)->constFirst(), 0), silent)) {
                 q->beginRemoveRows(QModelIndex(), i, i);
-                delete rowMap.takeAt(i); // Safe since we're iterating backwards.
+                removeFromMap(i); // Safe since we're iterating backwards.
                 q->endRemoveRows();
             }
         }
@@ -357,45 +595,36 @@ bool TaskGroupingProxyModel::Private::tryToGroup(const QModelIndex &sourceIndex,
 
     // Meat of the matter: Try to add this source row to a sub-list with source rows
     // associated with the same application.
-    for (int i = 0; i < rowMap.count(); ++i) {
-        const QModelIndex &groupRep = q->sourceModel()->index(rowMap.at(i)->constFirst(), 0);
-
-        // Don't match a row with itself.
-        if (sourceIndex == groupRep) {
-            continue;
-        }
+    QVector<int> *sourceRows = findGroupFor(sourceIndex);
 
-        // Don't group windows with anything other than windows.
-        if (!groupRep.data(AbstractTasksModel::IsWindow).toBool()) {
-            continue;
-        }
-
-        if (appsMatch(sourceIndex, groupRep)) {
-            const QModelIndex parent = q->index(i, 0);
+    if (!sourceRows) {
+        return false;
+    }
 
-            if (!silent) {
-                const int newIndex = rowMap.at(i)->count();
+    ensureLookup();
+    const int row = rowOfSubList.value(sourceRows);
+    const QModelIndex parent = q->index(row, 0);
 
-                if (newIndex == 1) {
-                    q->beginInsertRows(parent, 0, 1);
-                } else {
-                    q->beginInsertRows(parent, newIndex, newIndex);
-                }
-            }
+    if (!silent) {
+        const int newIndex = sourceRows->count();
 
-            rowMap[i]->append(sourceIndex.row());
+        if (newIndex == 1) {
+            q->beginInsertRows(parent, 0, 1);
+        } else {
+            q->beginInsertRows(parent, newIndex, newIndex);
+        }
+    }
 
-            if (!silent) {
-                q->endInsertRows();
+    sourceRows->append(sourceIndex.row());
+    setLocation(sourceIndex.row(), {row, sourceRows->count() - 1});
 
-                Q_EMIT q->dataChanged(parent, parent);
-            }
+    if (!silent) {
+        q->endInsertRows();
 
-            return true;
-        }
+        Q_EMIT q->dataChanged(parent, parent);
     }
 
-    return false;
+    return true;
 }
 
 void TaskGroupingProxyModel::Private::formGroupFor(const QModelIndex &index)
@@ -418,7 +647,7 @@ void TaskGroupingProxyModel::Private::formGroupFor(const QModelIndex &index)
 
         if (tryToGroup(sourceIndex)) {
             q->beginRemoveRows(QModelIndex(), i, i);
-            delete rowMap.takeAt(i); // Safe since we're iterating backwards.
+            removeFromMap(i); // Safe since we're iterating backwards.
             q->endRemoveRows();
         }
     }
@@ -445,6 +674,7 @@ void TaskGroupingProxyModel::Private::breakGroupFor(const QModelIndex &index, bo
     }
 
     rowMap[row]->resize(1);
+    lookupValid = false;
 
     if (!silent) {
         q->endRemoveRows();
@@ -456,7 +686,7 @@ void TaskGroupingProxyModel::Private::breakGroupFor(const QModelIndex &index, bo
     }
 
     for (int i = 0; i < extraChildren.count(); ++i) {
-        rowMap.append(new QVector<int>{extraChildren.at(i)});
+        appendToMap(new QVector<int>{extraChildren.at(i)});
     }
 
     if (!silent) {
@@ -496,7 +726,8 @@ QModelIndex TaskGroupingProxyModel::parent(const QModelIndex &child) const
     if (child.internalPointer() == nullptr) {
         return QModelIndex();
     } else {
-        const int parentRow = d->rowMap.indexOf(static_cast<QVector<int> *>(child.internalPointer()));
+        d->ensureLookup();
+        const int parentRow = d->rowOfSubList.value(static_cast<const QVector<int> *>(child.internalPointer()), -1);
 
         if (parentRow != -1) {
             return index(parentRow, 0);
@@ -516,28 +747,28 @@ QModelIndex TaskGroupingProxyModel::mapFromSource(const QModelIndex &sourceIndex
         return QModelIndex();
     }
 
-    for (int i = 0; i < d->rowMap.count(); ++i) {
-        const QVector<int> *sourceRows = d->rowMap.at(i);
-        const int childIndex = sourceRows->indexOf(sourceIndex.row());
-        const QModelIndex parent = index(i, 0);
-
-        if (childIndex == 0) {
-            // If the sub-list we found the source row in is larger than 1 (i.e. part
-            // of a group, map to the logical child item instead of the parent item
-            // the source row also stands in for. The parent is therefore unreachable
-            // from mapToSource().
-            if (d->isGroup(i)) {
-                return index(0, 0, parent);
-                // Otherwise map to the top-level item.
-            } else {
-                return parent;
-            }
-        } else if (childIndex != -1) {
-            return index(childIndex, 0, parent);
+    const Private::Location location = d->locate(sourceIndex.row());
+
+    if (location.row == -1) {
+        return QModelIndex();
+    }
+
+    const QModelIndex parent = index(location.row, 0);
+
+    if (location.childRow == 0) {
+        // If the sub-list we found the source row in is larger than 1 (i.e. part
+        // of a group, map to the logical child item instead of the parent item
+        // the source row also stands in for. The parent is therefore unreachable
+        // from mapToSource().
+        if (d->isGroup(location.row)) {
+            return index(0, 0, parent);
+            // Otherwise map to the top-level item.
+        } else {
+            return parent;
         }
     }
 
-    return QModelIndex();
+    return index(location.childRow, 0, parent);
 }
 
 QModelIndex TaskGroupingProxyModel::mapToSource(const QModelIndex &proxyIndex) const
@@ -777,7 +1008,7 @@ void TaskGroupingProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
         connect(sourceModel, &QSortFilterProxyModel::modelReset, this, std::bind(&TaskGroupingProxyModel::Private::sourceModelReset, dd));
         connect(sourceModel, &QSortFilterProxyModel::dataChanged, this, std::bind(&TaskGroupingProxyModel::Private::sourceDataChanged, dd, _1, _2, _3));
     } else {
-        d->rowMap.clear();
+        d->clearMap();
     }
 
     endResetModel();
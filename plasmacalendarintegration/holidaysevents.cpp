@@ -8,9 +8,13 @@
 
 #include <KConfigGroup>
 #include <QDebug>
+#include <QFileSystemWatcher>
+#include <QSet>
+#include <QStandardPaths>
 
 HolidaysEventsPlugin::HolidaysEventsPlugin(QObject *parent)
     : CalendarEvents::CalendarEventsPlugin(parent)
+    , m_watcher(new QFileSystemWatcher(this))
 {
     KSharedConfig::Ptr m_config = KSharedConfig::openConfig(QStringLiteral("plasma_calendar_holiday_regions"));
     const KConfigGroup regionsConfig = m_config->group("General");
@@ -26,6 +30,9 @@ HolidaysEventsPlugin::HolidaysEventsPlugin(QObject *parent)
     for (const QString &region : qAsConst(regionCodes)) {
         m_regions << new KHolidays::HolidayRegion(region);
     }
+
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &HolidaysEventsPlugin::invalidateHolidays);
+    watchHolidayFiles();
 }
 
 HolidaysEventsPlugin::~HolidaysEventsPlugin()
@@ -44,20 +51,26 @@ void HolidaysEventsPlugin::loadEventsForDateRange(const QDate &startDate, const
     QMultiHash<QDate, CalendarEvents::EventData> data;
 
     for (KHolidays::HolidayRegion *region : qAsConst(m_regions)) {
-        const KHolidays::Holiday::List holidays = region->holidays(startDate, endDate);
-
-        for (const KHolidays::Holiday &holiday : holidays) {
-            CalendarEvents::EventData eventData;
-            eventData.setStartDateTime(holiday.observedStartDate().startOfDay());
-            eventData.setEndDateTime(holiday.observedEndDate().endOfDay());
-            eventData.setIsAllDay(true);
-            eventData.setTitle(holiday.name());
-            eventData.setEventType(CalendarEvents::EventData::Holiday);
-            eventData.setIsMinor(false);
-
-            // make sure to add events spanning multiple days to all of them
-            for (QDate d = holiday.observedStartDate(); d <= holiday.observedEndDate(); d = d.addDays(1)) {
-                data.insert(d, eventData);
+        QSet<QPair<QDate, QString>> seen;
+
+        for (int year = startDate.year(); year <= endDate.year(); ++year) {
+            for (const CachedHoliday &holiday : holidaysOfYear(region, year)) {
+                if (holiday.endDate < startDate || holiday.startDate > endDate) {
+                    continue;
+                }
+                // holidays spanning the turn of the year can be listed in both years
+                if (holiday.startDate.year() != holiday.endDate.year()) {
+                    const auto key = qMakePair(holiday.startDate, holiday.eventData.title());
+                    if (seen.contains(key)) {
+                        continue;
+                    }
+                    seen.insert(key);
+                }
+
+                // make sure to add events spanning multiple days to all of them
+                for (QDate d = holiday.startDate; d <= holiday.endDate; d = d.addDays(1)) {
+                    data.insert(d, holiday.eventData);
+                }
             }
         }
     }
@@ -70,3 +83,64 @@ void HolidaysEventsPlugin::loadEventsForDateRange(const QDate &startDate, const
 
     Q_EMIT dataReady(data);
 }
+
+const QVector<HolidaysEventsPlugin::CachedHoliday> &HolidaysEventsPlugin::holidaysOfYear(KHolidays::HolidayRegion *region, int year)
+{
+    QHash<int, QVector<CachedHoliday>> &years = m_holidays[region->regionCode()];
+
+    auto it = years.find(year);
+    if (it != years.end()) {
+        return it.value();
+    }
+
+    const KHolidays::Holiday::List holidays = region->holidays(QDate(year, 1, 1), QDate(year, 12, 31));
+
+    QVector<CachedHoliday> cached;
+    cached.reserve(holidays.size());
+
+    for (const KHolidays::Holiday &holiday : holidays) {
+        CalendarEvents::EventData eventData;
+        eventData.setStartDateTime(holiday.observedStartDate().startOfDay());
+        eventData.setEndDateTime(holiday.observedEndDate().endOfDay());
+        eventData.setIsAllDay(true);
+        eventData.setTitle(holiday.name());
+        eventData.setEventType(CalendarEvents::EventData::Holiday);
+        eventData.setIsMinor(false);
+
+        cached.append({holiday.observedStartDate(), holiday.observedEndDate(), eventData});
+    }
+
+    return years.insert(year, cached).value();
+}
+
+void HolidaysEventsPlugin::watchHolidayFiles()
+{
+    // the holiday plan files shipped with KHolidays and the ones installed by users
+    const QStringList folders =
+        QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, QStringLiteral("kf5/libkholidays/plan2"), QStandardPaths::LocateDirectory);
+    if (!folders.isEmpty()) {
+        m_watcher->addPaths(folders);
+    }
+}
+
+void HolidaysEventsPlugin::invalidateHolidays()
+{
+    const QDate startDate = m_lastStartDate;
+    const QDate endDate = m_lastEndDate;
+
+    m_holidays.clear();
+    m_lastStartDate = QDate();
+    m_lastEndDate = QDate();
+
+    // the regions keep the parsed plan files around, load them again
+    for (KHolidays::HolidayRegion *&region : m_regions) {
+        const QString regionCode = region->regionCode();
+        delete region;
+        region = new KHolidays::HolidayRegion(regionCode);
+    }
+
+    // the calendar only asks again when it shows another range, give it the new holidays now
+    if (startDate.isValid() && endDate.isValid()) {
+        loadEventsForDateRange(startDate, endDate);
+    }
+}
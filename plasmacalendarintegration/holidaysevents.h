@@ -12,6 +12,8 @@
 #include <KHolidays/HolidayRegion>
 #include <KSharedConfig>
 
+class QFileSystemWatcher;
+
 class HolidaysEventsPlugin : public CalendarEvents::CalendarEventsPlugin
 {
     Q_OBJECT
@@ -25,9 +27,22 @@ public:
     void loadEventsForDateRange(const QDate &startDate, const QDate &endDate) override;
 
 private:
+    struct CachedHoliday {
+        QDate startDate;
+        QDate endDate;
+        CalendarEvents::EventData eventData;
+    };
+
+    // The holidays of the region observed during the year, evaluated once and cached
+    const QVector<CachedHoliday> &holidaysOfYear(KHolidays::HolidayRegion *region, int year);
+    void watchHolidayFiles();
+    void invalidateHolidays();
+
     QDate m_lastStartDate;
     QDate m_lastEndDate;
     QList<KHolidays::HolidayRegion *> m_regions;
     QMultiHash<QDate, CalendarEvents::EventData> m_lastData;
+    QHash<QString /*region code*/, QHash<int /*year*/, QVector<CachedHoliday>>> m_holidays;
+    QFileSystemWatcher *m_watcher;
     KSharedConfig::Ptr m_config;
 };
@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QElapsedTimer>
+#include <QFutureInterface>
+#include <QTest>
+#include <QTimer>
+
+#include <time.h>
+
+#include "futureutil.h"
+
+static qint64 threadCpuTimeMSecs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+class FutureUtilTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testAwaitFinished();
+    void testAwaitSlowFuture();
+};
+
+void FutureUtilTest::testAwaitFinished()
+{
+    QFutureInterface<int> interface;
+    interface.reportStarted();
+    interface.reportResult(42);
+    interface.reportFinished();
+
+    const QFuture<int> future = interface.future();
+    awaitFuture(future);
+    QCOMPARE(future.result(), 42);
+}
+
+void FutureUtilTest::testAwaitSlowFuture()
+{
+    QFutureInterface<int> interface;
+    interface.reportStarted();
+
+    // Finished from the event loop, which awaiting has to keep running
+    QTimer::singleShot(500, this, [&interface] {
+        interface.reportResult(42);
+        interface.reportFinished();
+    });
+
+    const QFuture<int> future = interface.future();
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    const qint64 cpuTime = threadCpuTimeMSecs();
+
+    awaitFuture(future);
+
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), 42);
+    QVERIFY(elapsed.elapsed() >= 450);
+
+    // Sleeping, rather than spinning for the whole time
+    QVERIFY2(threadCpuTimeMSecs() - cpuTime < 100, qPrintable(QString::number(threadCpuTimeMSecs() - cpuTime)));
+}
+
+QTEST_GUILESS_MAIN(FutureUtilTest)
+
+#include "futureutiltest.moc"
@@ -9,8 +9,10 @@
 #include "krunner_interface.h"
 #include "shellcorona.h"
 
+#include <QColor>
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QMetaProperty>
 #include <QQmlContext>
 #include <QQmlEngine>
 #include <QQuickItem>
@@ -59,6 +61,7 @@ DesktopView::DesktopView(Plasma::Corona *corona, QScreen *targetScreen)
 
     connect(this, &QWindow::screenChanged, this, &DesktopView::adaptToScreen);
     connect(this, &DesktopView::accentColorChanged, this, &DesktopView::setAccentColorFromWallpaper);
+    connect(this, &ContainmentView::containmentChanged, this, &DesktopView::findWallpaperItem);
 
     QObject::connect(corona, &Plasma::Corona::kPackageChanged, this, &DesktopView::coronaPackageChanged);
 
@@ -390,6 +393,61 @@ void DesktopView::setupWaylandIntegration()
     }
 }
 
+void DesktopView::findWallpaperItem()
+{
+    disconnect(m_containmentItemConnection);
+    disconnect(m_wallpaperInterfaceConnection);
+    disconnect(m_wallpaperAccentColorConnection);
+    m_wallpaperItem.clear();
+
+    QQuickItem *containmentItem = containment() ? containment()->property("_plasma_graphicObject").value<QQuickItem *>() : nullptr;
+    if (!containmentItem) {
+        return;
+    }
+
+    // Changing the wallpaper plugin replaces the wallpaper interface, a direct child of the containment,
+    // which in turn holds the root item of the wallpaper once it is loaded
+    m_containmentItemConnection = connect(containmentItem, &QQuickItem::childrenChanged, this, &DesktopView::findWallpaperItem);
+
+    const QList<QQuickItem *> containmentChildren = containmentItem->childItems();
+    for (QQuickItem *wallpaperInterface : containmentChildren) {
+        if (!wallpaperInterface->inherits("WallpaperInterface")) {
+            continue;
+        }
+
+        m_wallpaperInterfaceConnection = connect(wallpaperInterface, &QQuickItem::childrenChanged, this, &DesktopView::findWallpaperItem);
+
+        const QList<QQuickItem *> wallpaperChildren = wallpaperInterface->childItems();
+        for (QQuickItem *item : wallpaperChildren) {
+            const QMetaObject *metaObject = item->metaObject();
+            const QMetaProperty property = metaObject->property(metaObject->indexOfProperty("accentColor"));
+            if (!property.isValid() || !property.hasNotifySignal()) {
+                continue;
+            }
+
+            const QMetaMethod update = staticMetaObject.method(staticMetaObject.indexOfSlot("updateAccentColorFromWallpaperItem()"));
+            m_wallpaperItem = item;
+            m_wallpaperAccentColorConnection = connect(item, property.notifySignal(), this, update);
+            updateAccentColorFromWallpaperItem();
+            return;
+        }
+        return;
+    }
+}
+
+void DesktopView::updateAccentColorFromWallpaperItem()
+{
+    if (!m_wallpaperItem) {
+        return;
+    }
+
+    // Invalid until the wallpaper knows its color
+    const QColor color = m_wallpaperItem->property("accentColor").value<QColor>();
+    if (color.isValid()) {
+        setAccentColor(color.name());
+    }
+}
+
 void DesktopView::setAccentColorFromWallpaper(const QString &accentColor)
 {
     auto const notPrimaryDisplay = containment()->screen() != 0;
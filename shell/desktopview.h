@@ -12,6 +12,8 @@
 
 #include <KConfigWatcher>
 
+class QQuickItem;
+
 namespace KWayland
 {
 namespace Client
@@ -82,6 +84,7 @@ protected Q_SLOTS:
 
 private Q_SLOTS:
     void screenGeometryChanged();
+    void updateAccentColorFromWallpaperItem();
 
 Q_SIGNALS:
     void stayBehindChanged();
@@ -95,9 +98,15 @@ private:
     void ensureWindowType();
     void setupWaylandIntegration();
     void setAccentColorFromWallpaper(const QString &accentColor);
+    void findWallpaperItem();
     bool handleKRunnerTextInput(QKeyEvent *e);
 
     QString m_accentColor;
+    // the root item of the wallpaper, when it offers an accentColor property
+    QPointer<QQuickItem> m_wallpaperItem;
+    QMetaObject::Connection m_containmentItemConnection;
+    QMetaObject::Connection m_wallpaperInterfaceConnection;
+    QMetaObject::Connection m_wallpaperAccentColorConnection;
     QPointer<PlasmaQuick::ConfigView> m_configView;
     QPointer<QScreen> m_oldScreen;
     QPointer<QScreen> m_screenToFollow;
@@ -6,12 +6,28 @@
 
 #pragma once
 
-#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFuture>
+#include <QFutureWatcher>
 
+/**
+ * Blocks until @p future is finished, while still processing events.
+ *
+ * The local event loop sleeps until there is something to do instead of spinning,
+ * and leaves user input for later so that it can not trigger anything in between.
+ */
 template<typename T>
 inline void awaitFuture(const QFuture<T> &future)
 {
-    while (!future.isFinished()) {
-        QCoreApplication::processEvents();
+    if (future.isFinished()) {
+        return;
     }
+
+    QEventLoop loop;
+    QFutureWatcher<T> watcher;
+    QObject::connect(&watcher, &QFutureWatcherBase::finished, &loop, &QEventLoop::quit);
+    // Reports finished even if the future finished in the meantime
+    watcher.setFuture(future);
+
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
 }
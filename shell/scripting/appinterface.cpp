@@ -17,9 +17,10 @@
 #include <Plasma/Corona>
 #include <Plasma/DataEngine>
 #include <Plasma/DataEngineConsumer>
-#include <Plasma/PluginLoader>
 #include <Plasma/Theme>
 
+#include <appletmetadatacatalog.h>
+
 #ifdef Q_OS_WIN
 #include <windows.h>
 #endif
@@ -177,7 +178,7 @@ QStringList AppInterface::knownWidgetTypes() const
 {
     if (m_knownWidgets.isEmpty()) {
         QStringList widgets;
-        const QList<KPluginMetaData> plugins = Plasma::PluginLoader::self()->listAppletMetaData(QString());
+        const QList<KPluginMetaData> plugins = AppletMetaDataCatalog::self()->applets();
 
         for (const auto &plugin : plugins) {
             widgets.append(plugin.pluginId());
@@ -202,7 +203,7 @@ QStringList AppInterface::knownPanelTypes() const
 QStringList AppInterface::knownContainmentTypes(const QString &type) const
 {
     QStringList containments;
-    const QList<KPluginMetaData> plugins = Plasma::PluginLoader::listContainmentsMetaDataOfType(type);
+    const QList<KPluginMetaData> plugins = AppletMetaDataCatalog::self()->containmentsOfType(type);
 
     containments.reserve(plugins.count());
     for (const KPluginMetaData &plugin : plugins) {
@@ -30,6 +30,7 @@
 #include <Plasma/PluginLoader>
 #include <qstandardpaths.h>
 
+#include "../futureutil.h"
 #include "../screenpool.h"
 #include "../standaloneappcorona.h"
 #include "appinterface.h"
@@ -40,14 +41,6 @@
 
 namespace
 {
-template<typename T>
-inline void awaitFuture(const QFuture<T> &future)
-{
-    while (!future.isFinished()) {
-        QCoreApplication::processEvents();
-    }
-}
-
 class ScriptArray_forEach_Helper
 {
 public:
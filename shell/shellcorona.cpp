@@ -49,6 +49,8 @@
 #include <KWayland/Client/plasmawindowmanagement.h>
 #include <KWayland/Client/registry.h>
 
+#include <appletmetadatacatalog.h>
+
 #include "config-ktexteditor.h" // HAVE_KTEXTEDITOR
 
 #include "alternativeshelper.h"
@@ -1554,8 +1556,14 @@ void ShellCorona::insertActivity(const QString &id, const QString &plugin)
         return;
     }
 
-    while (m_activityController->currentActivity() != id) {
-        QCoreApplication::processEvents();
+    if (m_activityController->currentActivity() != id) {
+        QEventLoop loop;
+        connect(m_activityController, &KActivities::Controller::currentActivityChanged, &loop, [&loop, &id](const QString &currentActivity) {
+            if (currentActivity == id) {
+                loop.quit();
+            }
+        });
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
     }
 
     m_activityContainmentPlugins.insert(id, plugin);
@@ -1673,7 +1681,7 @@ void ShellCorona::checkAddPanelAction()
 
     m_addPanelsMenu.reset(nullptr);
 
-    const QList<KPluginMetaData> panelContainmentPlugins = Plasma::PluginLoader::listContainmentsMetaDataOfType(QStringLiteral("Panel"));
+    const QList<KPluginMetaData> panelContainmentPlugins = AppletMetaDataCatalog::self()->containmentsOfType(QStringLiteral("Panel"));
 
     auto filter = [](const KPluginMetaData &md) -> bool {
         return !md.rawData().value(QStringLiteral("NoDisplay")).toBool()
@@ -1705,7 +1713,7 @@ void ShellCorona::populateAddPanelsMenu()
     m_addPanelsMenu->clear();
     const KPluginMetaData emptyInfo;
 
-    const QList<KPluginMetaData> panelContainmentPlugins = Plasma::PluginLoader::listContainmentsMetaDataOfType(QStringLiteral("Panel"));
+    const QList<KPluginMetaData> panelContainmentPlugins = AppletMetaDataCatalog::self()->containmentsOfType(QStringLiteral("Panel"));
     QMap<QString, QPair<KPluginMetaData, KPluginMetaData>> sorted;
     for (const KPluginMetaData &plugin : panelContainmentPlugins) {
         if (plugin.rawData().value(QStringLiteral("NoDisplay")).toBool()) {
@@ -1750,7 +1758,7 @@ void ShellCorona::populateAddPanelsMenu()
 
 void ShellCorona::addPanel()
 {
-    const QList<KPluginMetaData> panelPlugins = Plasma::PluginLoader::listContainmentsMetaDataOfType(QStringLiteral("Panel"));
+    const QList<KPluginMetaData> panelPlugins = AppletMetaDataCatalog::self()->containmentsOfType(QStringLiteral("Panel"));
 
     if (!panelPlugins.isEmpty()) {
         addPanel(panelPlugins.first().pluginId());
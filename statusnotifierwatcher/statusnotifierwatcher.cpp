@@ -7,16 +7,24 @@
 #include "statusnotifierwatcher.h"
 
 #include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QDBusServiceWatcher>
 #include <QDebug>
 
 #include <kpluginfactory.h>
 
-#include "statusnotifieritem_interface.h"
+#include <algorithm>
+
 #include "statusnotifierwatcheradaptor.h"
 
 K_PLUGIN_CLASS_WITH_JSON(StatusNotifierWatcher, "statusnotifierwatcher.json")
 
+// Items registering around the same time, e.g. at login, are announced from one timer run.
+// The protocol has a signal per item so there are as many of them, but items that go away
+// within the interval are never announced.
+static const int s_announceInterval = 20;
+
 StatusNotifierWatcher::StatusNotifierWatcher(QObject *parent, const QList<QVariant> &)
     : KDEDModule(parent)
 {
@@ -31,6 +39,10 @@ StatusNotifierWatcher::StatusNotifierWatcher(QObject *parent, const QList<QVaria
     m_serviceWatcher->setWatchMode(QDBusServiceWatcher::WatchForUnregistration);
 
     connect(m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &StatusNotifierWatcher::serviceUnregistered);
+
+    m_announceTimer.setSingleShot(true);
+    m_announceTimer.setInterval(s_announceInterval);
+    connect(&m_announceTimer, &QTimer::timeout, this, &StatusNotifierWatcher::announceRegisteredItems);
 }
 
 StatusNotifierWatcher::~StatusNotifierWatcher()
@@ -51,28 +63,96 @@ void StatusNotifierWatcher::RegisterStatusNotifierItem(const QString &serviceOrP
         path = QStringLiteral("/StatusNotifierItem");
     }
     QString notifierItemId = service + path;
-    if (m_registeredServices.contains(notifierItemId)) {
+    if (m_registeredItems.contains(notifierItemId) || m_pendingItems.contains(notifierItemId)) {
         return;
     }
+
+    // Watched right away so that an item whose service goes away while it is checked is dropped
     m_serviceWatcher->addWatchedService(service);
-    if (QDBusConnection::sessionBus().interface()->isServiceRegistered(service).value()) {
-        // check if the service has registered a SystemTray object
-        org::kde::StatusNotifierItem trayclient(service, path, QDBusConnection::sessionBus());
-        if (trayclient.isValid()) {
-            qDebug() << "Registering" << notifierItemId << "to system tray";
-            m_registeredServices.append(notifierItemId);
-            Q_EMIT StatusNotifierItemRegistered(notifierItemId);
-        } else {
-            m_serviceWatcher->removeWatchedService(service);
-        }
-    } else {
+    m_pendingItems.insert(notifierItemId, service);
+
+    checkServiceRegistered(service, [this, notifierItemId, service](bool registered) {
+        itemValidated(notifierItemId, service, registered);
+    });
+}
+
+void StatusNotifierWatcher::checkServiceRegistered(const QString &service, const std::function<void(bool)> &callback)
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.DBus"),
+                                                      QStringLiteral("/org/freedesktop/DBus"),
+                                                      QStringLiteral("org.freedesktop.DBus"),
+                                                      QStringLiteral("NameHasOwner"));
+    msg << service;
+
+    auto *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [callback](QDBusPendingCallWatcher *watcher) {
+        QDBusPendingReply<bool> reply = *watcher;
+        watcher->deleteLater();
+        callback(!reply.isError() && reply.value());
+    });
+}
+
+void StatusNotifierWatcher::itemValidated(const QString &notifierItemId, const QString &service, bool valid)
+{
+    // Its service went away in the meantime
+    if (m_pendingItems.take(notifierItemId).isNull()) {
+        return;
+    }
+
+    if (!valid) {
+        unwatchServiceIfUnused(service);
+        return;
+    }
+
+    qDebug() << "Registering" << notifierItemId << "to system tray";
+    m_registeredItems.insert(notifierItemId, m_registrationCount++);
+    m_itemsForService[service].insert(notifierItemId);
+
+    m_unannouncedItems.append(notifierItemId);
+    if (!m_announceTimer.isActive()) {
+        m_announceTimer.start();
+    }
+}
+
+void StatusNotifierWatcher::announceRegisteredItems()
+{
+    const QStringList items = m_unannouncedItems;
+    m_unannouncedItems.clear();
+
+    for (const QString &notifierItemId : items) {
+        Q_EMIT StatusNotifierItemRegistered(notifierItemId);
+    }
+}
+
+void StatusNotifierWatcher::unwatchServiceIfUnused(const QString &service)
+{
+    if (m_itemsForService.contains(service) || m_statusNotifierHostServices.contains(service) || m_pendingHostServices.contains(service)) {
+        return;
+    }
+
+    const bool pending = std::any_of(m_pendingItems.cbegin(), m_pendingItems.cend(), [&service](const QString &pendingService) {
+        return pendingService == service;
+    });
+    if (!pending) {
         m_serviceWatcher->removeWatchedService(service);
     }
 }
 
 QStringList StatusNotifierWatcher::RegisteredStatusNotifierItems() const
 {
-    return m_registeredServices;
+    // Hosts learn about the ones not announced yet through StatusNotifierItemRegistered shortly
+    QStringList items;
+    items.reserve(m_registeredItems.count());
+    for (auto it = m_registeredItems.cbegin(); it != m_registeredItems.cend(); ++it) {
+        if (!m_unannouncedItems.contains(it.key())) {
+            items.append(it.key());
+        }
+    }
+
+    std::sort(items.begin(), items.end(), [this](const QString &a, const QString &b) {
+        return m_registeredItems.value(a) < m_registeredItems.value(b);
+    });
+    return items;
 }
 
 void StatusNotifierWatcher::serviceUnregistered(const QString &name)
@@ -80,18 +160,28 @@ void StatusNotifierWatcher::serviceUnregistered(const QString &name)
     qDebug() << "Service " << name << "unregistered";
     m_serviceWatcher->removeWatchedService(name);
 
-    const QString match = name + QLatin1Char('/');
-    QStringList::Iterator it = m_registeredServices.begin();
-    while (it != m_registeredServices.end()) {
-        if (it->startsWith(match)) {
-            QString name = *it;
-            it = m_registeredServices.erase(it);
-            Q_EMIT StatusNotifierItemUnregistered(name);
+    for (auto it = m_pendingItems.begin(); it != m_pendingItems.end();) {
+        if (it.value() == name) {
+            it = m_pendingItems.erase(it);
         } else {
             ++it;
         }
     }
 
+    const QSet<QString> items = m_itemsForService.take(name);
+    for (const QString &notifierItemId : items) {
+        m_registeredItems.remove(notifierItemId);
+
+        // Nobody was told about it yet
+        if (m_unannouncedItems.removeOne(notifierItemId)) {
+            continue;
+        }
+
+        Q_EMIT StatusNotifierItemUnregistered(notifierItemId);
+    }
+
+    m_pendingHostServices.remove(name);
+
     if (m_statusNotifierHostServices.contains(name)) {
         m_statusNotifierHostServices.remove(name);
         Q_EMIT StatusNotifierHostUnregistered();
@@ -100,14 +190,29 @@ void StatusNotifierWatcher::serviceUnregistered(const QString &name)
 
 void StatusNotifierWatcher::RegisterStatusNotifierHost(const QString &service)
 {
-    if (service.contains(QLatin1String("org.kde.StatusNotifierHost-")) && QDBusConnection::sessionBus().interface()->isServiceRegistered(service).value()
-        && !m_statusNotifierHostServices.contains(service)) {
+    if (!service.contains(QLatin1String("org.kde.StatusNotifierHost-")) || m_statusNotifierHostServices.contains(service)
+        || m_pendingHostServices.contains(service)) {
+        return;
+    }
+
+    m_serviceWatcher->addWatchedService(service);
+    m_pendingHostServices.insert(service);
+
+    checkServiceRegistered(service, [this, service](bool registered) {
+        if (!m_pendingHostServices.remove(service)) {
+            return;
+        }
+
+        if (!registered) {
+            unwatchServiceIfUnused(service);
+            return;
+        }
+
         qDebug() << "Registering" << service << "as system tray";
 
         m_statusNotifierHostServices.insert(service);
-        m_serviceWatcher->addWatchedService(service);
         Q_EMIT StatusNotifierHostRegistered();
-    }
+    });
 }
 
 bool StatusNotifierWatcher::IsStatusNotifierHostRegistered() const
@@ -9,9 +9,13 @@
 #include <kdedmodule.h>
 
 #include <QDBusContext>
+#include <QHash>
 #include <QObject>
 #include <QSet>
 #include <QStringList>
+#include <QTimer>
+
+#include <functional>
 
 class QDBusServiceWatcher;
 
@@ -48,7 +52,26 @@ Q_SIGNALS:
     void StatusNotifierHostUnregistered();
 
 private:
+    // Asks the bus whether the service is around, without waiting for the answer
+    void checkServiceRegistered(const QString &service, const std::function<void(bool)> &callback);
+    void itemValidated(const QString &notifierItemId, const QString &service, bool valid);
+    void announceRegisteredItems();
+    void unwatchServiceIfUnused(const QString &service);
+
     QDBusServiceWatcher *m_serviceWatcher = nullptr;
-    QStringList m_registeredServices;
+
+    // Items by id (service + path), with the order they registered in
+    QHash<QString, quint64> m_registeredItems;
+    quint64 m_registrationCount = 0;
+    // Item ids by service, to drop them when it goes away
+    QHash<QString, QSet<QString>> m_itemsForService;
+
+    // Items waiting for their service to be checked, by id
+    QHash<QString, QString> m_pendingItems;
+    // Registered items StatusNotifierItemRegistered still has to be emitted for
+    QStringList m_unannouncedItems;
+    QTimer m_announceTimer;
+
+    QSet<QString> m_pendingHostServices;
     QSet<QString> m_statusNotifierHostServices;
 };
\ No newline at end of file
@@ -22,6 +22,9 @@ QQC2.StackView {
     readonly property string configColor: wallpaper.configuration.Color
     readonly property bool blur: wallpaper.configuration.Blur
     readonly property size sourceSize: Qt.size(root.width * Screen.devicePixelRatio, root.height * Screen.devicePixelRatio)
+    // Read by the desktop view, which applies it when the accent color follows the wallpaper.
+    // Only changes when the color does, not on every new slide
+    readonly property color accentColor: imageWallpaper.accentColor
 
     // Ppublic API functions accessible from C++:
 
@@ -0,0 +1,65 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "colorextractor.h"
+#include <QtTest>
+
+class TestColorExtractor : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testExtract_data();
+    void testExtract();
+};
+
+namespace
+{
+// An image of the size wallpapers are decoded at, with the right @p share of it in @p second
+QImage twoTone(const QColor &first, const QColor &second, qreal share)
+{
+    QImage image(64, 64, QImage::Format_ARGB32);
+    image.fill(first);
+
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = qRound(image.width() * (1 - share)); x < image.width(); ++x) {
+            image.setPixelColor(x, y, second);
+        }
+    }
+
+    return image;
+}
+}
+
+void TestColorExtractor::testExtract_data()
+{
+    QTest::addColumn<QImage>("image");
+    QTest::addColumn<QColor>("expected");
+
+    const QColor red(200, 40, 40);
+    const QColor green(40, 160, 60);
+    const QColor blue(30, 60, 200);
+    const QColor gray(128, 128, 128);
+
+    QTest::newRow("solid") << twoTone(red, red, 0) << red;
+    QTest::newRow("solid gray") << twoTone(gray, gray, 0) << gray;
+    QTest::newRow("two-tone, larger area") << twoTone(red, green, 0.25) << red;
+    QTest::newRow("two-tone, colorful over gray") << twoTone(gray, blue, 0.25) << blue;
+    QTest::newRow("two-tone, colorful over white") << twoTone(Qt::white, blue, 0.25) << blue;
+    QTest::newRow("transparent") << twoTone(Qt::transparent, Qt::transparent, 0) << QColor();
+    QTest::newRow("transparent over most of it") << twoTone(Qt::transparent, green, 0.25) << green;
+    QTest::newRow("empty") << QImage() << QColor();
+}
+
+void TestColorExtractor::testExtract()
+{
+    QFETCH(QImage, image);
+    QFETCH(QColor, expected);
+
+    QCOMPARE(ColorExtractor::extract(image), expected);
+}
+
+QTEST_GUILESS_MAIN(TestColorExtractor)
+#include "testcolorextractor.moc"
@@ -0,0 +1,170 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "colorextractor.h"
+
+#include <QCache>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QtConcurrentRun>
+
+#include <vector>
+
+namespace
+{
+// Size images are decoded at, plenty to tell their colors apart
+constexpr int s_sampleSize = 64;
+// 4 bits per channel, transparent pixels go to the upper half which is never looked at
+constexpr int s_binCount = 1 << 12;
+
+struct CachedColor {
+    qint64 lastModified;
+    QColor color;
+};
+
+// Only used from the main thread, shared by all wallpapers.
+// Bounded, as a slideshow over a large folder would otherwise keep every image it ever showed
+QCache<QString, CachedColor> &colorCache()
+{
+    static QCache<QString, CachedColor> s_cache(1000);
+    return s_cache;
+}
+
+QColor extractFromFile(const QString &path)
+{
+    QImageReader reader(path);
+
+    // Most formats can decode at a lower size directly, which is much cheaper
+    const QSize size = reader.size();
+    if (size.isValid() && (size.width() > s_sampleSize || size.height() > s_sampleSize)) {
+        reader.setScaledSize(size.scaled(s_sampleSize, s_sampleSize, Qt::KeepAspectRatio).expandedTo(QSize(1, 1)));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return QColor();
+    }
+
+    if (image.width() > s_sampleSize || image.height() > s_sampleSize) {
+        image = image.scaled(s_sampleSize, s_sampleSize, Qt::KeepAspectRatio, Qt::FastTransformation);
+    }
+
+    return ColorExtractor::extract(image);
+}
+}
+
+ColorExtractor::ColorExtractor(QObject *parent)
+    : QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcherBase::finished, this, [this] {
+        const QColor color = m_watcher.result();
+        colorCache().insert(m_path, new CachedColor{m_lastModified, color});
+        setColor(color);
+    });
+}
+
+ColorExtractor::~ColorExtractor() = default;
+
+QColor ColorExtractor::color() const
+{
+    return m_color;
+}
+
+void ColorExtractor::setPath(const QString &path)
+{
+    m_path = path;
+
+    if (path.isEmpty()) {
+        m_watcher.setFuture(QFuture<QColor>());
+        setColor(QColor());
+        return;
+    }
+
+    m_lastModified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+
+    const CachedColor *cached = colorCache().object(path);
+    if (cached && cached->lastModified == m_lastModified) {
+        // Results of an image set before are of no use anymore
+        m_watcher.setFuture(QFuture<QColor>());
+        setColor(cached->color);
+        return;
+    }
+
+    // The previous color stays until the new one is known, to not flicker through an invalid one
+    m_watcher.setFuture(QtConcurrent::run([path] {
+        return extractFromFile(path);
+    }));
+}
+
+void ColorExtractor::setColor(const QColor &color)
+{
+    if (m_color == color) {
+        return;
+    }
+
+    m_color = color;
+    Q_EMIT colorChanged();
+}
+
+QColor ColorExtractor::extract(const QImage &source)
+{
+    const QImage image = source.convertToFormat(QImage::Format_ARGB32);
+    const int width = image.width();
+
+    std::vector<quint32> counts(2 * s_binCount, 0);
+    std::vector<quint32> reds(2 * s_binCount, 0);
+    std::vector<quint32> greens(2 * s_binCount, 0);
+    std::vector<quint32> blues(2 * s_binCount, 0);
+    std::vector<quint16> bins(width);
+
+    for (int y = 0; y < image.height(); ++y) {
+        const quint32 *line = reinterpret_cast<const quint32 *>(image.constScanLine(y));
+
+        // Branchless on purpose, so that the compiler can vectorize it:
+        // the top 4 bits of every channel, plus one bit when the pixel is mostly transparent
+        for (int x = 0; x < width; ++x) {
+            const quint32 pixel = line[x];
+            bins[x] = ((pixel >> 12) & 0xf00) | ((pixel >> 8) & 0xf0) | ((pixel >> 4) & 0xf) | ((~pixel >> 19) & 0x1000);
+        }
+
+        for (int x = 0; x < width; ++x) {
+            const quint32 pixel = line[x];
+            const int bin = bins[x];
+            ++counts[bin];
+            reds[bin] += qRed(pixel);
+            greens[bin] += qGreen(pixel);
+            blues[bin] += qBlue(pixel);
+        }
+    }
+
+    QColor best;
+    qreal bestScore = 0;
+
+    for (int bin = 0; bin < s_binCount; ++bin) {
+        const quint32 count = counts[bin];
+        if (!count) {
+            continue;
+        }
+
+        const QColor color(reds[bin] / count, greens[bin] / count, blues[bin] / count);
+
+        // Colorful areas make for a better accent than large gray ones,
+        // and one close to black or white does not stand out at all
+        qreal score = count * (0.2 + color.hslSaturationF());
+        const qreal lightness = color.lightnessF();
+        if (lightness < 0.15 || lightness > 0.85) {
+            score *= 0.2;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            best = color;
+        }
+    }
+
+    return best;
+}
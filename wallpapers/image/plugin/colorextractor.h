@@ -0,0 +1,58 @@
+/*
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QColor>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QObject>
+#include <QString>
+
+/**
+ * Finds the color that stands out in a wallpaper image, to be used as accent color.
+ *
+ * Images are decoded at a small size on the global thread pool and their pixels
+ * binned in a coarse RGB histogram. Results are remembered per file and modification
+ * time, so that a slideshow going through its images again does not decode them again.
+ */
+class ColorExtractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ColorExtractor(QObject *parent = nullptr);
+    ~ColorExtractor() override;
+
+    /**
+     * The accent color of the current image, invalid until it is known
+     */
+    QColor color() const;
+
+    /**
+     * Sets the image to extract the color of
+     */
+    void setPath(const QString &path);
+
+    /**
+     * The accent color of an already decoded image
+     */
+    static QColor extract(const QImage &image);
+
+Q_SIGNALS:
+    /**
+     * Emitted when the accent color differs from the one of the previous image
+     */
+    void colorChanged();
+
+private:
+    void setColor(const QColor &color);
+
+    QString m_path;
+    qint64 m_lastModified = 0;
+    QColor m_color;
+    QFutureWatcher<QColor> m_watcher;
+};
@@ -37,6 +37,7 @@
 #include <klocalizedstring.h>
 
 #include "backgroundlistmodel.h"
+#include "colorextractor.h"
 #include "slidefiltermodel.h"
 #include "slidemodel.h"
 #include <Plasma/PluginLoader>
@@ -57,6 +58,7 @@ ImageBackend::ImageBackend(QObject *parent)
     , m_model(nullptr)
     , m_slideFilterModel(new SlideFilterModel(this))
     , m_dialog(nullptr)
+    , m_colorExtractor(new ColorExtractor(this))
 {
     m_wallpaperPackage = KPackage::PackageLoader::self()->loadPackage(QStringLiteral("Wallpaper/Images"));
 
@@ -67,6 +69,11 @@ ImageBackend::ImageBackend(QObject *parent)
     connect(m_dirWatch, &KDirWatch::deleted, this, &ImageBackend::pathDeleted);
     m_dirWatch->startScan();
 
+    connect(this, &ImageBackend::wallpaperPathChanged, this, [this] {
+        m_colorExtractor->setPath(m_wallpaperPath);
+    });
+    connect(m_colorExtractor, &ColorExtractor::colorChanged, this, &ImageBackend::accentColorChanged);
+
     useSingleImageDefaults();
 }
 
@@ -105,6 +112,11 @@ QUrl ImageBackend::wallpaperPath() const
     return QUrl::fromLocalFile(m_wallpaperPath);
 }
 
+QColor ImageBackend::accentColor() const
+{
+    return m_colorExtractor->color();
+}
+
 void ImageBackend::addUrl(const QString &url)
 {
     addUrl(QUrl(url), true);
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <QColor>
 #include <QDateTime>
 #include <QObject>
 #include <QPersistentModelIndex>
@@ -29,6 +30,7 @@ class QQuickItem;
 class KDirWatch;
 class KJob;
 class BackgroundListModel;
+class ColorExtractor;
 class SlideModel;
 class SlideFilterModel;
 
@@ -49,6 +51,10 @@ class ImageBackend : public QObject, public QQmlParserStatus, public SortingMode
     Q_PROPERTY(QSize targetSize READ targetSize WRITE setTargetSize NOTIFY targetSizeChanged)
     Q_PROPERTY(QString photosPath READ photosPath CONSTANT)
     Q_PROPERTY(QStringList uncheckedSlides READ uncheckedSlides WRITE setUncheckedSlides NOTIFY uncheckedSlidesChanged)
+    /**
+     * The color standing out in the current image, invalid while it is not known yet
+     */
+    Q_PROPERTY(QColor accentColor READ accentColor NOTIFY accentColorChanged)
 
 public:
     enum RenderingMode {
@@ -114,6 +120,8 @@ public:
     QStringList uncheckedSlides() const;
     void setUncheckedSlides(const QStringList &uncheckedSlides);
 
+    QColor accentColor() const;
+
 public Q_SLOTS:
     void nextSlide();
     void removeWallpaper(QString name);
@@ -131,6 +139,7 @@ Q_SIGNALS:
     void resizeMethodChanged();
     void customWallpaperPicked(const QString &path);
     void uncheckedSlidesChanged();
+    void accentColorChanged();
 
 protected Q_SLOTS:
     void showAddSlidePathsDialog();
@@ -183,4 +192,5 @@ private:
     QString m_img;
     QDateTime m_previousModified;
     QString m_findToken;
+    ColorExtractor *m_colorExtractor;
 };